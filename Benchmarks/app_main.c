@@ -6,7 +6,9 @@
 
 void app_main(void)
 {
-#if defined SCHED_LLREF
+#if defined SCHED_DPFAIR
+    printf("We are running dpfair\n");
+#elif defined SCHED_LLREF
     printf("We are running llref\n");
 #elif defined SCHED_EDF
     printf("We are running edf\n");
@@ -16,7 +18,15 @@ void app_main(void)
     #error Unknown scheduler
 #endif
 
+#if defined BENCHMARK_READY_QUEUE
+    run_ready_queue_benchmark();
+#elif defined BENCHMARK_PERIODIC
+    run_periodic_benchmark();
+#elif defined BENCHMARK_TASKSETS
+    run_tasksets_benchmark();
+#else
     run_benchmarks();
+#endif
 
     vTaskStartScheduler();
 
@@ -5,86 +5,45 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <limits.h>
-#include <stdatomic.h>
 #include "benchmarks.h"
+#include "trace.h"
 #include <string.h>
 
-#define BENCHMARK_WORKERS 8
-#define MAX_EVENTS_PER_QUEUE 64
+#define WORKER_COUNT 8
 #define TASK_CREATION_COUNT 255
 
-typedef enum
-{
-    e_TaskArrived,
-    e_TaskStarted,
-    e_TaskFinished
-} EventType;
-
-typedef struct
-{
-    EventType type;
-    Time_t time;
-
-    union
-    {
-        struct
-        {
-            uint32_t worker_id;
-        } arrived;
-
-        struct
-        {
-            uint32_t worker_id;
-        } started;
-
-        struct
-        {
-            uint32_t worker_id;
-        } finished;
-    } data;
-} Event;
-
-typedef struct
-{
-    _Atomic uint32_t eventCount;
-    Event events[MAX_EVENTS_PER_QUEUE];
-} EventQueue;
-
 typedef struct 
 {
     uint32_t deadline;
     uint32_t runtime;
     uint32_t id;
     StaticTask_t tcb;
-    EventQueue* queue;
 } BenchmarkData;
 
 static StackType_t watcher_stack[1024];
 static StaticTask_t watcher_tcb;
-static StackType_t worker_stacks[BENCHMARK_WORKERS][1024];
-static BenchmarkData worker_data[BENCHMARK_WORKERS];
+static StackType_t worker_stacks[WORKER_COUNT][1024];
+static BenchmarkData worker_data[WORKER_COUNT];
 static StaticEventGroup_t event_storage;
 static EventGroupHandle_t finished_event;
 
-static EventQueue eQueue;
-
-void push_event(Event* event)
-{
-    uint32_t idx = atomic_fetch_add(&eQueue.eventCount, 1);
-    eQueue.events[idx] = *event;
-}
+// For the utilization figures, printed with the trace
+static Time_t arrival_time;
+static Time_t finish_times[WORKER_COUNT];
+#if defined SCHED_LLREF
+// Printed by the watcher once every worker is done, not while they run
+static TickType_t remaining_times[WORKER_COUNT];
+#if ( configNUMBER_OF_CORES > 1 )
+static UBaseType_t migration_counts[WORKER_COUNT];
+#endif
+#endif
 
 static void benchmark_worker(void* data)
 {
-    Event e;
     BenchmarkData* bData = (BenchmarkData*)data;
     const uint32_t cycles = bData->runtime * 250000;
-    printf("Task %d started\n", bData->id);
 
-    e.type = e_TaskStarted;
-    e.time = get_current_time();
-    e.data.started.worker_id = bData->id;
-    push_event(&e);
+    trace_job(e_TraceJobStarted, xTaskGetCurrentTaskHandle());
 
     volatile uint32_t dummy = 0;
     for(uint32_t i = 0; i < cycles; ++i)
@@ -92,16 +51,14 @@ static void benchmark_worker(void* data)
         dummy += i;
     }
     
-    e.type = e_TaskFinished;
-    e.time = get_current_time();
-    e.data.finished.worker_id = bData->id;
-    push_event(&e);
+    finish_times[bData->id] = get_current_time();
+    trace_job(e_TraceJobFinished, xTaskGetCurrentTaskHandle());
 
 #if defined SCHED_LLREF
-    TickType_t remaining = pubGetxRemainingExecutionTime(xTaskGetCurrentTaskHandle());
-    printf("Task %d ended with %d remaining\n", bData->id, remaining);
-#else
-    printf("Task %d ended\n", bData->id);
+    remaining_times[bData->id] = pubGetxRemainingExecutionTime(xTaskGetCurrentTaskHandle());
+#if ( configNUMBER_OF_CORES > 1 )
+    migration_counts[bData->id] = uxTaskGetMigrationCount(NULL);
+#endif
 #endif
     // Let the watcher know we are done here
     xEventGroupSetBits(finished_event, 1 << bData->id);
@@ -110,7 +67,7 @@ static void benchmark_worker(void* data)
 }
 
 #ifdef SCHED_EDF
-static TickType_t deadlines[BENCHMARK_WORKERS] = 
+static TickType_t deadlines[WORKER_COUNT] = 
 {
     90,
     60,
@@ -124,7 +81,7 @@ static TickType_t deadlines[BENCHMARK_WORKERS] =
 #endif
 
 #if defined PLATFORM_RPI
-static TickType_t execution_times[BENCHMARK_WORKERS] = 
+static TickType_t execution_times[WORKER_COUNT] = 
 {
     11802,
     18165,
@@ -135,8 +92,8 @@ static TickType_t execution_times[BENCHMARK_WORKERS] =
     4137,
     18837
 };
-#elif defined PLATFORM_QEMU
-static TickType_t execution_times[BENCHMARK_WORKERS] = 
+#elif defined PLATFORM_QEMU || defined PLATFORM_POSIX
+static TickType_t execution_times[WORKER_COUNT] = 
 {
     36,
     74,
@@ -149,7 +106,7 @@ static TickType_t execution_times[BENCHMARK_WORKERS] =
 };
 #endif
 
-void create_benchmark_task(uint32_t id, uint32_t deadlineMs, uint32_t runtimeMs)
+TaskHandle_t create_benchmark_task(uint32_t id, uint32_t deadlineMs, uint32_t runtimeMs)
 {
     BenchmarkData* data = &worker_data[id];
     char name[128];
@@ -179,40 +136,63 @@ void create_benchmark_task(uint32_t id, uint32_t deadlineMs, uint32_t runtimeMs)
         &worker_stacks[id][0],
         &worker_data[id].tcb
     );
+
+    return handle;
 }
 
-void watcher(void* args)
+#if defined USE_SMP
+static void print_core_utilization(void)
 {
-    EventQueue* queues[BENCHMARK_WORKERS];
-    uint32_t event_count;
+    // The makespan is from the tasks arriving to the last one finishing
+    Time_t last_finish = 0;
+
+    for(uint32_t i = 0; i < WORKER_COUNT; ++i)
+    {
+        if(finish_times[i] > last_finish)
+            last_finish = finish_times[i];
+    }
+
+    Time_t makespan = last_finish - arrival_time;
+    printf("Makespan | %d ms\n", (uint32_t)(makespan / get_time_frequency_ms()));
+
+    for(uint32_t i = 0; i < configNUMBER_OF_CORES; ++i)
+    {
+        Time_t busy = get_core_busy_time(i);
+        uint32_t percent = makespan == 0 ? 0 : (uint32_t)(((uint64_t)busy * 100) / makespan);
+
+        // Busy time is counted from when the scheduler started, so it can go a bit over 100%
+        printf("Core%d | %d ms busy | %d%% utilization\n", i, (uint32_t)(busy / get_time_frequency_ms()), percent);
+    }
+}
+#endif
 
-    xEventGroupSync(finished_event, 0, (1 << BENCHMARK_WORKERS) - 1, portMAX_DELAY);
+void watcher(void* args)
+{
+    xEventGroupSync(finished_event, 0, (1 << WORKER_COUNT) - 1, portMAX_DELAY);
     printf("All tasks done\n");
 
-    event_count = eQueue.eventCount;
+#if defined SCHED_LLREF
+    for(uint32_t i = 0; i < WORKER_COUNT; ++i)
+    {
+#if ( configNUMBER_OF_CORES > 1 )
+        printf("Task %d ended with %d remaining after %u migrations\n", i, remaining_times[i],
+               (unsigned) migration_counts[i]);
+#else
+        printf("Task %d ended with %d remaining\n", i, remaining_times[i]);
+#endif
+    }
+#endif
 
     printf("%d context switches occured\n", get_context_switch_count());
-    printf("Total events: %d\n", event_count);
 
+    // The arrivals, starts, finishes and switches are all in the trace, see
+    // trace_format.py for reading it
     printf("---OUTPUT START---\n");
-    for(uint32_t i = 0; i < event_count; ++i)
-    {
-        Event* current = &eQueue.events[i];
-        uint32_t ms = current->time / get_time_frequency_ms();
+    trace_dump();
 
-        if(current->type == e_TaskArrived)
-        {
-            printf("%d ms | ARRIVE task%d\n", ms, current->data.finished.worker_id);
-        }
-        if(current->type == e_TaskStarted)
-        {
-            printf("%d ms | START task%d\n", ms, current->data.finished.worker_id);
-        }
-        else if(current->type == e_TaskFinished)
-        {
-            printf("%d ms | END task%d\n", ms, current->data.finished.worker_id);
-        }
-    }
+#if defined USE_SMP
+    print_core_utilization();
+#endif
 
     printf("----OUTPUT END----\n");
     app_abort();
@@ -246,13 +226,576 @@ void task_creation_benchmark()
         }
     }
 
-    printf("Ending %d\n", get_current_time() / get_time_frequency_ms());
+    printf("Ending %d\n", (uint32_t)(get_current_time() / get_time_frequency_ms()));
+    app_abort();
+}
+
+#if defined PLATFORM_RPI
+#define READY_QUEUE_MAX_TASKS 128
+#else
+#define READY_QUEUE_MAX_TASKS 256
+#endif
+#define READY_QUEUE_ROUNDS 64
+
+static StackType_t ready_queue_driver_stack[1024];
+static StaticTask_t ready_queue_driver_tcb;
+static StackType_t ready_queue_stacks[READY_QUEUE_MAX_TASKS][configMINIMAL_STACK_SIZE];
+static StaticTask_t ready_queue_tcbs[READY_QUEUE_MAX_TASKS];
+static TaskHandle_t ready_queue_handles[READY_QUEUE_MAX_TASKS];
+
+static void ready_queue_filler(void* args)
+{
+    // Only becomes ready while the driver is measuring, it should never get to run
+    for(;;)
+    {
+        vTaskSuspend(NULL);
+    }
+}
+
+static TickType_t ready_queue_parameter(uint32_t id)
+{
+    // Spread the tasks over the queue so inserts do not always land at one end
+    uint32_t spread = (id * 7919) % 10007;
+
+#if defined SCHED_EDF
+    return 1000 + spread; // Always later than the driver
+#elif defined SCHED_LLREF
+    return 1 + spread; // Always less remaining time than the driver
+#elif defined SCHED_DEFAULT
+    return 1 + (spread % (configMAX_PRIORITIES - 2)); // Always lower than the driver
+#else
+    #error Unknown scheduler
+#endif
+}
+
+static uint32_t ready_queue_ns_per_op(Time_t elapsed, uint32_t ops)
+{
+    return (uint32_t)(((uint64_t)elapsed * 1000000) / ((uint64_t)get_time_frequency_ms() * ops));
+}
+
+static void ready_queue_driver(void* args)
+{
+    static const uint32_t task_counts[] = { 8, 16, 32, 64, 128, 256 };
+    uint32_t created = 0;
+
+    printf("---OUTPUT START---\n");
+    for(uint32_t c = 0; c < sizeof(task_counts) / sizeof(task_counts[0]); ++c)
+    {
+        uint32_t count = task_counts[c];
+        Time_t enqueue_time = 0;
+        Time_t dequeue_time = 0;
+
+        if(count > READY_QUEUE_MAX_TASKS)
+            break;
+
+        for(; created < count; ++created)
+        {
+            ready_queue_handles[created] = xTaskCreateStatic(
+                ready_queue_filler,
+                "RQFiller",
+                configMINIMAL_STACK_SIZE,
+                NULL,
+                ready_queue_parameter(created),
+                &ready_queue_stacks[created][0],
+                &ready_queue_tcbs[created]
+            );
+#if defined USE_SMP
+            // Keep the fillers on the driver's core so they never run
+            vTaskCoreAffinitySet(ready_queue_handles[created], 1 << 0);
+#endif
+        }
+
+        // Every filler is ready at this point, each round takes them all out of
+        // the ready queue and puts them back in again
+        for(uint32_t round = 0; round < READY_QUEUE_ROUNDS; ++round)
+        {
+            Time_t start = get_current_time();
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                vTaskSuspend(ready_queue_handles[i]);
+            }
+
+            Time_t middle = get_current_time();
+            for(uint32_t i = 0; i < count; ++i)
+            {
+                vTaskResume(ready_queue_handles[i]);
+            }
+
+            dequeue_time += middle - start;
+            enqueue_time += get_current_time() - middle;
+        }
+
+        printf("%d tasks | %d ns enqueue | %d ns dequeue\n",
+            count,
+            ready_queue_ns_per_op(enqueue_time, count * READY_QUEUE_ROUNDS),
+            ready_queue_ns_per_op(dequeue_time, count * READY_QUEUE_ROUNDS));
+    }
+    printf("----OUTPUT END----\n");
+
     app_abort();
 }
 
+void run_ready_queue_benchmark(void)
+{
+    TaskHandle_t handle = xTaskCreateStatic(
+        ready_queue_driver,
+        "RQDriver",
+        sizeof(ready_queue_driver_stack) / sizeof(ready_queue_driver_stack[0]),
+        NULL,
+#if defined SCHED_LLREF
+        (TickType_t)-1, // Big number so it runs first
+#elif defined SCHED_EDF
+        1, // Earlier than any of the fillers
+#elif defined SCHED_DEFAULT
+        configMAX_PRIORITIES - 1,
+#else
+        #error Unknown scheduler
+#endif
+        ready_queue_driver_stack,
+        &ready_queue_driver_tcb
+    );
+
+#if defined USE_SMP
+    vTaskCoreAffinitySet(handle, 1 << 0);
+#else
+    (void)handle;
+#endif
+
+    vTaskStartScheduler();
+
+    printf("Benchmarks finished");
+}
+
+// A benchmark that counts over a number of ticks has its counts taken by the
+// tick hook at the last of them. The task that prints them may only get to run
+// later, in slack under llref and dpfair, and would otherwise count over a
+// longer window than the other schedulers.
+static void (*volatile window_snapshot)(void);
+static TickType_t window_end;
+static volatile bool window_closed;
+
+static inline void window_open(TickType_t end, void (*snapshot)(void))
+{
+    taskENTER_CRITICAL();
+    window_end = end;
+    window_closed = false;
+    window_snapshot = snapshot;
+    taskEXIT_CRITICAL();
+}
+
+// Returns once the snapshot has been taken
+static inline void window_wait(void)
+{
+    while(!window_closed)
+    {
+        vTaskDelay(1);
+    }
+}
+
+void benchmark_tick_hook(void)
+{
+    void (*snapshot)(void) = window_snapshot;
+
+    // A tick can be missed while the scheduler is suspended, so the window is
+    // closed on the first tick at or after its end
+    if(snapshot != NULL &&
+       (TickType_t)(xTaskGetTickCountFromISR() - window_end) < (TickType_t)(portMAX_DELAY >> 1))
+    {
+        snapshot();
+        window_snapshot = NULL;
+        window_closed = true;
+    }
+}
+
+// The same periodic task set for llref and dpfair, so their context switch
+// counts can be compared. Utilization is 0.85 of a core, or 1.7 with SMP.
+#define PERIODIC_TASKS 4
+#define PERIODIC_HYPERPERIOD 120
+#define PERIODIC_HYPERPERIODS 10
+
+#if defined SCHED_LLREF
+static const TickType_t periodic_periods[PERIODIC_TASKS] = { 20, 30, 40, 60 };
+#if defined USE_SMP
+static const TickType_t periodic_wcets[PERIODIC_TASKS] = { 8, 12, 20, 24 };
+#else
+static const TickType_t periodic_wcets[PERIODIC_TASKS] = { 4, 6, 10, 12 };
+#endif
+
+static StackType_t periodic_stacks[PERIODIC_TASKS][configMINIMAL_STACK_SIZE * 2];
+static StaticTask_t periodic_tcbs[PERIODIC_TASKS];
+static TaskHandle_t periodic_handles[PERIODIC_TASKS];
+static volatile uint32_t periodic_jobs[PERIODIC_TASKS];
+static volatile uint32_t periodic_misses[PERIODIC_TASKS];
+static TickType_t periodic_start;
+static uint32_t periodic_jobs_at_end[PERIODIC_TASKS];
+static uint32_t periodic_misses_at_end[PERIODIC_TASKS];
+static uint32_t periodic_switches_at_end;
+
+static StackType_t periodic_driver_stack[1024];
+static StaticTask_t periodic_driver_tcb;
+
+static void periodic_worker(void* args)
+{
+    uint32_t id = (uint32_t)(uintptr_t)args;
+
+    for(;;)
+    {
+        TickType_t release = periodic_start + periodic_jobs[id] * periodic_periods[id];
+
+        // Use up exactly the job's execution time
+        while(pubGetxRemainingExecutionTime(NULL) > 0) {}
+
+        if((TickType_t)(xTaskGetTickCount() - release) > periodic_periods[id])
+        {
+            periodic_misses[id]++;
+        }
+        periodic_jobs[id]++;
+
+        vTaskWaitForNextPeriod();
+    }
+}
+
+static void periodic_snapshot(void)
+{
+    for(uint32_t i = 0; i < PERIODIC_TASKS; ++i)
+    {
+        periodic_jobs_at_end[i] = periodic_jobs[i];
+        periodic_misses_at_end[i] = periodic_misses[i];
+    }
+    periodic_switches_at_end = get_context_switch_count();
+}
+
+static void periodic_driver(void* args)
+{
+    uint32_t switches;
+
+    periodic_start = xTaskGetTickCount();
+    switches = get_context_switch_count();
+    window_open(periodic_start + PERIODIC_HYPERPERIOD * PERIODIC_HYPERPERIODS, periodic_snapshot);
+    for(uint32_t i = 0; i < PERIODIC_TASKS; ++i)
+    {
+        periodic_handles[i] = xTaskCreatePeriodicStatic(
+            periodic_worker,
+            "Periodic",
+            sizeof(periodic_stacks[0]) / sizeof(periodic_stacks[0][0]),
+            (void*)(uintptr_t)i,
+            periodic_periods[i],
+            periodic_wcets[i],
+            &periodic_stacks[i][0],
+            &periodic_tcbs[i]
+        );
+    }
+
+    vTaskDelay(PERIODIC_HYPERPERIOD * PERIODIC_HYPERPERIODS);
+    window_wait();
+    switches = periodic_switches_at_end - switches;
+
+    printf("---OUTPUT START---\n");
+    printf("%d context switches in %d hyperperiods\n", switches, PERIODIC_HYPERPERIODS);
+    for(uint32_t i = 0; i < PERIODIC_TASKS; ++i)
+    {
+#if defined USE_SMP
+        printf("task%d | %d jobs | %d missed | %u migrations\n", i, periodic_jobs_at_end[i], periodic_misses_at_end[i],
+            (unsigned)uxTaskGetMigrationCount(periodic_handles[i]));
+#else
+        printf("task%d | %d jobs | %d missed\n", i, periodic_jobs_at_end[i], periodic_misses_at_end[i]);
+#endif
+    }
+    printf("----OUTPUT END----\n");
+
+    app_abort();
+}
+#endif
+
+void run_periodic_benchmark(void)
+{
+#if defined SCHED_LLREF
+    xTaskCreateStatic(
+        periodic_driver,
+        "PDriver",
+        sizeof(periodic_driver_stack) / sizeof(periodic_driver_stack[0]),
+        NULL,
+        (TickType_t)-1, // Big number so it runs first
+        periodic_driver_stack,
+        &periodic_driver_tcb
+    );
+
+    vTaskStartScheduler();
+#else
+    printf("The periodic benchmark needs the llref or dpfair target\n");
+    app_abort();
+#endif
+}
+
+#if defined BENCHMARK_TASKSETS
+// Runs every generated task set one after the other and reports the jobs that
+// finished after their implicit deadline. Regenerate the sets with
+// tasksets.py, the build does it from TASKSET_ARGS.
+#include "tasksets.h"
+
+#if TASKSETS_CORES != configNUMBER_OF_CORES
+#error The task sets were generated for a different number of cores, regenerate them with tasksets.py --cores
+#endif
+
+typedef struct
+{
+    TickType_t period;
+    TickType_t wcet;
+    TickType_t start;
+    volatile uint32_t jobs;
+    volatile uint32_t misses;
+    uint32_t jobs_at_end;
+    uint32_t misses_at_end;
+} TaskSetWorker;
+
+static StackType_t tasksets_stacks[TASKSETS_MAX_TASKS][configMINIMAL_STACK_SIZE * 2];
+static StaticTask_t tasksets_tcbs[TASKSETS_MAX_TASKS];
+static TaskHandle_t tasksets_handles[TASKSETS_MAX_TASKS];
+static TaskSetWorker tasksets_workers[TASKSETS_MAX_TASKS];
+
+static uint32_t tasksets_count;
+static uint32_t tasksets_switches_at_end;
+
+static StackType_t tasksets_driver_stack[1024];
+static StaticTask_t tasksets_driver_tcb;
+
+// Spins until the task has run for just under the given ticks, counted from
+// when it was switched in to start the job or from the given time if it did not
+// have to wait for the job. When the task is switched out and back in, only the
+// time since it was switched back in is its own. The time the kernel spends in
+// the tick interrupt is counted, as the kernel charges it to the task too. A
+// twentieth of a tick is left for the rest of the job's loop.
+static void tasksets_burn(TickType_t ticks, Time_t from)
+{
+    const Time_t per_tick = (get_time_frequency_ms() * 1000) / configTICK_RATE_HZ;
+    Time_t needed = ticks * per_tick - per_tick / 20;
+    uint32_t switches = get_context_switch_count();
+    Time_t last = get_switched_in_time();
+
+    if(last < from)
+    {
+        last = from;
+    }
+
+    while(needed > 0)
+    {
+        uint32_t now_switches = get_context_switch_count();
+        Time_t now = get_current_time();
+        Time_t ran = now - last;
+
+        if(now_switches != switches)
+        {
+            Time_t since = get_switched_in_time();
+            if(since > now)
+            {
+                ran = 0;
+            }
+            else if(since > last)
+            {
+                ran = now - since;
+            }
+            switches = now_switches;
+        }
+        last = now;
+        needed = (ran >= needed) ? 0 : needed - ran;
+    }
+}
+
+static void tasksets_worker(void* args)
+{
+    TaskSetWorker* worker = (TaskSetWorker*)args;
+    Time_t done = 0;
+#if defined SCHED_DEFAULT
+    TickType_t wake = worker->start;
+#endif
+
+    for(;;)
+    {
+        // The same work under every scheduler, so a miss is the scheduler's
+        tasksets_burn(worker->wcet, done);
+
+        // Job n is due at the start of period n + 1
+        if((TickType_t)(xTaskGetTickCount() - worker->start) > (worker->jobs + 1) * worker->period)
+        {
+            worker->misses++;
+        }
+        worker->jobs++;
+
+        done = get_current_time();
+#if defined SCHED_DEFAULT
+        xTaskDelayUntil(&wake, worker->period);
+#else
+        vTaskWaitForNextPeriod();
+#endif
+    }
+}
+
+#if defined SCHED_DEFAULT
+// Rate monotonic, the shortest period gets the highest priority under the
+// driver. Tasks share the lowest priority once they run out.
+static UBaseType_t tasksets_priority(const TaskSet* set, uint32_t id)
+{
+    UBaseType_t rank = 0;
+    for(uint32_t i = 0; i < set->count; ++i)
+    {
+        if(set->periods[i] < set->periods[id] || (set->periods[i] == set->periods[id] && i < id))
+        {
+            rank++;
+        }
+    }
+
+    if(rank >= configMAX_PRIORITIES - 2)
+    {
+        return 1;
+    }
+    return configMAX_PRIORITIES - 2 - rank;
+}
+#endif
+
+static void tasksets_snapshot(void)
+{
+    for(uint32_t i = 0; i < tasksets_count; ++i)
+    {
+        tasksets_workers[i].jobs_at_end = tasksets_workers[i].jobs;
+        tasksets_workers[i].misses_at_end = tasksets_workers[i].misses;
+    }
+    tasksets_switches_at_end = get_context_switch_count();
+}
+
+static void tasksets_driver(void* args)
+{
+    printf("---OUTPUT START---\n");
+    for(uint32_t s = 0; s < TASKSETS_COUNT; ++s)
+    {
+        const TaskSet* set = &tasksets[s];
+        uint32_t jobs = 0;
+        uint32_t misses = 0;
+        uint32_t switches;
+
+        switches = get_context_switch_count();
+
+        // The driver runs after every worker, so the set is created with the
+        // scheduler suspended for all of their first jobs to be released at
+        // the tick they take as their start
+        vTaskSuspendAll();
+        tasksets_count = set->count;
+        window_open(xTaskGetTickCount() + set->duration, tasksets_snapshot);
+        for(uint32_t i = 0; i < set->count; ++i)
+        {
+            TaskSetWorker* worker = &tasksets_workers[i];
+            worker->period = set->periods[i];
+            worker->wcet = set->wcets[i];
+            worker->start = xTaskGetTickCount();
+            worker->jobs = 0;
+            worker->misses = 0;
+
+#if defined SCHED_DEFAULT
+            tasksets_handles[i] = xTaskCreateStatic(
+                tasksets_worker,
+                "TSWorker",
+                sizeof(tasksets_stacks[0]) / sizeof(tasksets_stacks[0][0]),
+                worker,
+                tasksets_priority(set, i),
+                &tasksets_stacks[i][0],
+                &tasksets_tcbs[i]
+            );
+#else
+            tasksets_handles[i] = xTaskCreatePeriodicStatic(
+                tasksets_worker,
+                "TSWorker",
+                sizeof(tasksets_stacks[0]) / sizeof(tasksets_stacks[0][0]),
+                worker,
+                worker->period,
+#if defined SCHED_EDF
+                worker->period, // Implicit deadline
+#endif
+                worker->wcet,
+                &tasksets_stacks[i][0],
+                &tasksets_tcbs[i]
+            );
+#endif
+        }
+        xTaskResumeAll();
+
+        vTaskDelay(set->duration);
+        window_wait();
+
+        for(uint32_t i = 0; i < set->count; ++i)
+        {
+            TaskSetWorker* worker = &tasksets_workers[i];
+
+            // A task that was not admitted has nothing to delete, its jobs are
+            // all counted as missed below
+            if(tasksets_handles[i] != NULL)
+            {
+                vTaskDelete(tasksets_handles[i]);
+            }
+
+            // Jobs that were due by the end of the window and never finished
+            // have missed too, a task that was starved would not have noticed
+            TickType_t due = set->duration / worker->period;
+            if(due > worker->jobs_at_end)
+            {
+                worker->misses_at_end += due - worker->jobs_at_end;
+                worker->jobs_at_end = due;
+            }
+
+            jobs += worker->jobs_at_end;
+            misses += worker->misses_at_end;
+        }
+        switches = tasksets_switches_at_end - switches;
+
+        printf("set %u | level %u | util %u | %u ticks | %u jobs | %u missed | %u switches\n",
+            (unsigned)s, (unsigned)set->level, (unsigned)set->utilization, (unsigned)set->duration,
+            (unsigned)jobs, (unsigned)misses, (unsigned)switches);
+
+        // Let the idle task finish off workers that were deleted while
+        // running on the other core before their buffers are used again
+        vTaskDelay(2);
+    }
+    printf("----OUTPUT END----\n");
+
+    app_abort();
+}
+#endif
+
+void run_tasksets_benchmark(void)
+{
+#if defined BENCHMARK_TASKSETS
+    TaskHandle_t handle = xTaskCreateStatic(
+        tasksets_driver,
+        "TSDriver",
+        sizeof(tasksets_driver_stack) / sizeof(tasksets_driver_stack[0]),
+        NULL,
+#if defined SCHED_LLREF
+        (TickType_t)-1, // Big number so it runs first
+#elif defined SCHED_EDF
+        1, // Earlier than any of the workers
+#elif defined SCHED_DEFAULT
+        configMAX_PRIORITIES - 1,
+#else
+        #error Unknown scheduler
+#endif
+        tasksets_driver_stack,
+        &tasksets_driver_tcb
+    );
+
+#if defined USE_SMP
+    vTaskCoreAffinitySet(handle, 1 << 0);
+#else
+    (void)handle;
+#endif
+
+    vTaskStartScheduler();
+#else
+    printf("The tasksets benchmark needs BENCHMARK=tasksets\n");
+    app_abort();
+#endif
+}
+
 void run_benchmarks(void)
 {
-    Event e;
+    TaskHandle_t handles[WORKER_COUNT];
 
     finished_event = xEventGroupCreateStatic(&event_storage);
     if(!finished_event)
@@ -279,29 +822,26 @@ void run_benchmarks(void)
         &watcher_tcb
     );
 
-    for(int i = 0; i < BENCHMARK_WORKERS; ++i)
+    for(int i = 0; i < WORKER_COUNT; ++i)
     {
         // We can do about 21 cycles every tick on the rpi
         // We can do about 2 cycles every tick on qemu
         // These both assume no execessive logging
 
-        #if defined PLATFORM_QEMU
+        #if defined PLATFORM_QEMU || defined PLATFORM_POSIX
         uint32_t divisor = 1;
         #elif defined PLATFORM_RPI
         uint32_t divisor = 19;
         #endif
 
-        create_benchmark_task(i, 0, execution_times[i] / divisor);
+        handles[i] = create_benchmark_task(i, 0, execution_times[i] / divisor);
     }
 
     // All tasks arrive at the same time
-    e.type = e_TaskArrived;
-    e.time = get_current_time();
-    for(uint32_t i = 0; i < BENCHMARK_WORKERS; ++i)
+    arrival_time = get_current_time();
+    for(uint32_t i = 0; i < WORKER_COUNT; ++i)
     {
-        e.data.arrived.worker_id = i;
-
-        push_event(&e);
+        trace_job(e_TraceJobArrived, handles[i]);
     }
 
     vTaskStartScheduler();
@@ -3,5 +3,10 @@
 
 void run_benchmarks(void);
 void task_creation_benchmark();
+void run_ready_queue_benchmark(void);
+void run_periodic_benchmark(void);
+void run_tasksets_benchmark(void);
+// Called from vApplicationTickHook()
+void benchmark_tick_hook(void);
 
 #endif
@@ -1,12 +1,19 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdbool.h>
 #include "FreeRTOS.h"
 #include "task.h"
 #include "semihosting.h"
+#include "trace.h"
+#include "benchmarks.h"
 #ifdef PLATFORM_RPI
 #include "pico/stdlib.h"
 #endif
+#ifdef PLATFORM_POSIX
+#include <stdlib.h>
+#include <time.h>
+#endif
 
 extern void app_main(void);
 
@@ -25,10 +32,76 @@ static void prvUARTInit( void )
     UART0_CTRL = 1;
 }
 
+#if defined PLATFORM_QEMU
+/* The time base on qemu is CMSDK timer 0, left counting down from its largest
+ * reload value at the system clock and extended to 64 bits in software.  Timer
+ * 0 interrupts each time it wraps so the wrap is seen even if nothing reads the
+ * time for a whole period. */
+#define TIMER0_ADDRESS                        ( 0x40000000UL )
+#define TIMER0_CTRL                           ( *( ( ( volatile uint32_t * ) ( TIMER0_ADDRESS + 0UL ) ) ) )
+#define TIMER0_VALUE                          ( *( ( ( volatile uint32_t * ) ( TIMER0_ADDRESS + 4UL ) ) ) )
+#define TIMER0_RELOAD                         ( *( ( ( volatile uint32_t * ) ( TIMER0_ADDRESS + 8UL ) ) ) )
+#define TIMER0_INTCLEAR                       ( *( ( ( volatile uint32_t * ) ( TIMER0_ADDRESS + 12UL ) ) ) )
+#define TIMER0_CTRL_ENABLE                    ( 1UL << 0 )
+#define TIMER0_CTRL_INTERRUPT                 ( 1UL << 3 )
+#define TIMER0_IRQ                            ( 8UL )
+#define NVIC_ISER0                            ( *( ( volatile uint32_t * ) 0xE000E100UL ) )
+#define NVIC_IPR( irq )                       ( *( ( volatile uint8_t * ) ( 0xE000E400UL + ( irq ) ) ) )
+
+static uint32_t timer_high;
+static uint32_t timer_last;
+
+static void prvTimerInit( void )
+{
+    TIMER0_RELOAD = 0xFFFFFFFFUL;
+    TIMER0_VALUE = 0xFFFFFFFFUL;
+    NVIC_IPR( TIMER0_IRQ ) = 0xFF;
+    NVIC_ISER0 = 1UL << TIMER0_IRQ;
+    TIMER0_CTRL = TIMER0_CTRL_ENABLE | TIMER0_CTRL_INTERRUPT;
+}
+
+static Time_t prvTimerRead( void )
+{
+    uint32_t primask;
+    uint32_t low;
+    Time_t now;
+
+    // Called from tasks, the kernel and the timer interrupt, so the extension
+    // is updated with interrupts off.  This is a few instructions, not a trap.
+    __asm volatile ( "mrs %0, primask\n"
+                     "cpsid i" : "=r" ( primask ) :: "memory" );
+
+    low = 0xFFFFFFFFUL - TIMER0_VALUE;
+    if( low < timer_last )
+    {
+        timer_high++;
+    }
+    timer_last = low;
+    now = ( ( Time_t ) timer_high << 32 ) | low;
+
+    __asm volatile ( "msr primask, %0" :: "r" ( primask ) : "memory" );
+
+    return now;
+}
+
+void TIMER0_Handler( void )
+{
+    TIMER0_INTCLEAR = 1;
+    ( void ) prvTimerRead();
+}
+#endif
+
+#if defined PLATFORM_POSIX
+// The host clock does not start at 0 like the timers of the boards, so times
+// are taken from when the program started
+static Time_t start_time;
+#endif
+
 void main(void)
 {
 #if defined PLATFORM_QEMU
     prvUARTInit();
+    prvTimerInit();
     printf("Running on qemu\n");
 #elif defined PLATFORM_RPI
     stdio_init_all();
@@ -38,6 +111,9 @@ void main(void)
     #else
         printf("Running on rpi without SMP\n");
     #endif
+#elif defined PLATFORM_POSIX
+    start_time = get_current_time();
+    printf("Running on posix\n");
 #endif
     app_main();
     return;
@@ -57,6 +133,11 @@ void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
 {
 }
 
+void vApplicationTickHook(void)
+{
+    benchmark_tick_hook();
+}
+
 #ifdef USE_SMP
 void vApplicationGetPassiveIdleTaskMemory(StaticTask_t ** ppxIdleTaskTCBBuffer,
                                           StackType_t ** ppxIdleTaskStackBuffer,
@@ -75,7 +156,7 @@ void vApplicationGetPassiveIdleTaskMemory(StaticTask_t ** ppxIdleTaskTCBBuffer,
 
 void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer,
                                    StackType_t **ppxIdleTaskStackBuffer,
-                                   uint32_t *pulIdleTaskStackSize)
+                                   configSTACK_DEPTH_TYPE *pulIdleTaskStackSize)
 {
     /* If the buffers to be provided to the Idle task are declared inside this
     function then they must be declared static - otherwise they will be allocated on
@@ -104,7 +185,7 @@ application must provide an implementation of vApplicationGetTimerTaskMemory()
 to provide the memory that is used by the Timer service task. */
 void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer,
                                     StackType_t **ppxTimerTaskStackBuffer,
-                                    uint32_t *pulTimerTaskStackSize)
+                                    configSTACK_DEPTH_TYPE *pulTimerTaskStackSize)
 {
     /* If the buffers to be provided to the Timer task are declared inside this
     function then they must be declared static - otherwise they will be allocated on
@@ -137,20 +218,26 @@ void app_abort(void)
 #elif defined PLATFORM_RPI
     printf("App aborted\n");
     while(1) {}
+#elif defined PLATFORM_POSIX
+    exit(0);
 #else
     #error Not implemented
 #endif
 }
 
-#define CLOCK_DIVISOR 100000
-
 Time_t get_current_time(void)
 {
 #if defined PLATFORM_QEMU
-    return (semihosting_elapsed() / CLOCK_DIVISOR);
+    return prvTimerRead();
 #elif defined PLATFORM_RPI
-    absolute_time_t time = get_absolute_time();
-    return to_ms_since_boot(time);
+    // The rp2040 timer is already 64 bits and counts microseconds
+    return time_us_64();
+#elif defined PLATFORM_POSIX
+    // The host's monotonic clock in nanoseconds
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (Time_t)now.tv_sec * 1000000000ULL + (Time_t)now.tv_nsec - start_time;
 #else
     #error Not implemented
 #endif
@@ -159,40 +246,82 @@ Time_t get_current_time(void)
 Time_t get_time_frequency_ms(void)
 {
 #if defined PLATFORM_QEMU
-    return semihosting_tickfreq() / (1000 * CLOCK_DIVISOR);
+    return configCPU_CLOCK_HZ / 1000; // Timer 0 runs at the system clock
 #elif defined PLATFORM_RPI
-    return 1; // It's already in ms on rpi
+    return 1000;
+#elif defined PLATFORM_POSIX
+    return 1000000;
 #else
     #error Not implemented
 #endif
 }
 
 static uint32_t context_switch_count = 0;
+static TaskHandle_t previous_tasks[configNUMBER_OF_CORES];
+static Time_t switched_in_at[configNUMBER_OF_CORES];
 
-void print_new_task(void)
-{
 #if defined USE_SMP
-    static TaskHandle_t previous_tasks[configNUMBER_OF_CORES];
+static Time_t core_busy_time[configNUMBER_OF_CORES];
+
+static bool is_idle_task(TaskHandle_t task)
+{
+    // Idle tasks are not pinned, so any of them can be on any core
     for(uint32_t i = 0; i < configNUMBER_OF_CORES; ++i)
     {
-        TaskHandle_t task = xTaskGetCurrentTaskHandleForCore(i);
-
-        if(previous_tasks[i] != task)
-        {
-            printf("%d | Core%d: %s\n", xTaskGetTickCount(), i, pcTaskGetName(task));
-            previous_tasks[i] = task;
-        }
+        if(task == xTaskGetIdleTaskHandleForCore(i))
+            return true;
     }
+
+    return false;
+}
+
+Time_t get_core_busy_time(uint32_t core)
+{
+    Time_t busy = core_busy_time[core];
+
+    // Count the task that is running right now as well
+    if(previous_tasks[core] != NULL && !is_idle_task(previous_tasks[core]))
+        busy += get_current_time() - switched_in_at[core];
+
+    return busy;
+}
+#endif
+
+void task_switched_in(void)
+{
+    // Called on the core that is switching, so each core only ever writes to
+    // its own trace ring and bookkeeping
+    uint32_t core = portGET_CORE_ID();
+#if defined USE_SMP
+    TaskHandle_t task = xTaskGetCurrentTaskHandleForCore(core);
 #else
-    TaskHandle_t newTask = xTaskGetCurrentTaskHandle();
-    const char* name = pcTaskGetName(newTask);
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+#endif
+
+    // The kernel also calls this when it picks the task that was already
+    // running, which is not a switch
+    if(previous_tasks[core] != task)
+    {
+        Time_t now = get_current_time();
 
-    printf("%d | Core0: %s\n", xTaskGetTickCount(), name);
+#if defined USE_SMP
+        if(previous_tasks[core] != NULL && !is_idle_task(previous_tasks[core]))
+            core_busy_time[core] += now - switched_in_at[core];
 #endif
+
+        trace_push(e_TraceTaskSwitchedIn, task);
+        switched_in_at[core] = now;
+        previous_tasks[core] = task;
+    }
     context_switch_count++;
 }
 
 uint32_t get_context_switch_count()
 {
     return context_switch_count;
+}
+
+Time_t get_switched_in_time(void)
+{
+    return switched_in_at[portGET_CORE_ID()];
 }
\ No newline at end of file
@@ -1,25 +1,72 @@
 #include "semihosting.h"
 #include <stdio.h>
+#include <string.h>
 
+#define SYS_OPEN (0x01)
+#define SYS_CLOSE (0x02)
+#define SYS_WRITE (0x05)
 #define SYS_CLOCK (0x10)
 #define SYS_EXIT (0x18)
 #define SYS_ELAPSED (0x30)
 #define SYS_TICKFREQ (0x31)
 
+#define ADP_STOPPED_APPLICATION_EXIT (0x20026)
+
 static uint32_t semihost_call(uint32_t op, uint32_t param)
 {
-    uint32_t res;
+    // The host reads the op and parameter from r0 and r1 and returns in r0.
+    // The parameter is often the address of a block on the stack, so the
+    // "memory" clobber keeps the stores to it from being dropped or moved past
+    // the call.
+    register uint32_t r0 __asm("r0") = op;
+    register uint32_t r1 __asm("r1") = param;
 
     __asm volatile (
-        "MOV r0, %[aop]\n"
-        "MOV r1, %[aparam]\n" 
-        "BKPT #0xAB\n"
-        "MOV %[out], r0"
-        : [out] "=r" (res)
-        : [aop] "r" (op), [aparam] "r" (param)
+        "BKPT #0xAB"
+        : "+r" (r0)
+        : "r" (r1)
+        : "memory"
     );
 
-    return res;
+    return r0;
+}
+
+int32_t semihosting_open(const char* path, uint32_t mode)
+{
+    struct
+    {
+        const char* path;
+        uint32_t mode;
+        uint32_t length;
+    } data;
+
+    data.path = path;
+    data.mode = mode;
+    data.length = strlen(path);
+
+    return (int32_t)semihost_call(SYS_OPEN, (uint32_t)&data);
+}
+
+uint32_t semihosting_write(int32_t handle, const void* buffer, uint32_t length)
+{
+    struct
+    {
+        int32_t handle;
+        const void* buffer;
+        uint32_t length;
+    } data;
+
+    data.handle = handle;
+    data.buffer = buffer;
+    data.length = length;
+
+    // The host returns how many bytes it did not write
+    return semihost_call(SYS_WRITE, (uint32_t)&data);
+}
+
+int32_t semihosting_close(int32_t handle)
+{
+    return (int32_t)semihost_call(SYS_CLOSE, (uint32_t)&handle);
 }
 
 uint32_t semihosting_clock()
@@ -46,16 +93,9 @@ uint32_t semihosting_tickfreq()
 
 _Noreturn void semihosting_exit()
 {
-    struct
-    {
-        uint32_t type;
-        uint32_t subcode;
-    } data;
-    
-    data.type = 0x20024; // ADP_Stopped_InternalError
-    data.subcode = 1;
-
-    semihost_call(SYS_EXIT, (uint32_t)&data);
+    // On AArch32 the reason code is passed in r1 itself rather than in a
+    // block, and qemu exits with status 0 only for ADP_Stopped_ApplicationExit
+    semihost_call(SYS_EXIT, ADP_STOPPED_APPLICATION_EXIT);
 
     while(1) {} // This should not be reached
 }
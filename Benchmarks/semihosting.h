@@ -3,6 +3,12 @@
 
 #include <stdint.h>
 
+// Mode for semihosting_open, as "wb" for fopen
+#define SEMIHOSTING_MODE_WB (5)
+
+int32_t semihosting_open(const char* path, uint32_t mode);
+uint32_t semihosting_write(int32_t handle, const void* buffer, uint32_t length);
+int32_t semihosting_close(int32_t handle);
 uint32_t semihosting_clock();
 uint64_t semihosting_elapsed();
 uint32_t semihosting_tickfreq();
@@ -0,0 +1,247 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "trace.h"
+#include "defs.h"
+#if defined PLATFORM_QEMU
+#include "semihosting.h"
+#endif
+
+#define TRACE_BUFFER_MASK (TRACE_BUFFER_LENGTH - 1)
+// Bytes of the trace on each line of the console dump
+#define TRACE_LINE_BYTES 32
+
+#if defined PLATFORM_QEMU
+// On qemu the trace is written to a file on the host with semihosting, a few
+// large writes rather than a character at a time through the UART. The path
+// is relative to where qemu was started.
+#define TRACE_FILE "trace.bin"
+#define TRACE_CHUNK_BYTES 16384
+#else
+#define TRACE_CHUNK_BYTES 1024
+#endif
+
+_Static_assert((TRACE_BUFFER_LENGTH & TRACE_BUFFER_MASK) == 0, "TRACE_BUFFER_LENGTH must be a power of two");
+
+// Each core only writes to its own ring, so a ring has a single producer (the
+// context switch on that core, or a task on it through trace_job) and a single
+// consumer (trace_dump). Neither side has to lock, the producer only moves head
+// and the consumer only moves tail.
+typedef struct
+{
+    _Atomic uint32_t head;
+    _Atomic uint32_t tail;
+    uint32_t dropped;
+    TraceRecord records[TRACE_BUFFER_LENGTH];
+} TraceRing;
+
+static TraceRing rings[configNUMBER_OF_CORES];
+static char task_names[TRACE_MAX_TASKS][configMAX_TASK_NAME_LEN];
+static UBaseType_t next_task_number = 1;
+
+void trace_task_created(void *task)
+{
+    // The kernel leaves the task number for the application to set, number the
+    // tasks in the order they are created so records can name them
+    UBaseType_t number = next_task_number++;
+    vTaskSetTaskNumber((TaskHandle_t)task, number);
+
+    // Creating a task is not on the path being measured, so the name is
+    // copied here rather than on every switch
+    if(number < TRACE_MAX_TASKS)
+        strncpy(task_names[number], pcTaskGetName((TaskHandle_t)task), configMAX_TASK_NAME_LEN - 1);
+}
+
+void trace_push(TraceEventType type, TaskHandle_t task)
+{
+    uint32_t core = portGET_CORE_ID();
+    TraceRing* ring = &rings[core];
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    // Drop the record rather than overwrite one the consumer may be reading
+    if(head - tail >= TRACE_BUFFER_LENGTH)
+    {
+        ring->dropped++;
+        return;
+    }
+
+    TraceRecord* record = &ring->records[head & TRACE_BUFFER_MASK];
+    record->time = get_current_time();
+    record->task = (uint16_t)uxTaskGetTaskNumber(task);
+    record->core = (uint8_t)core;
+    record->type = (uint8_t)type;
+    record->reserved = 0;
+
+    // Publish the record only once it is written
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+void trace_job(TraceEventType type, TaskHandle_t task)
+{
+    // The context switch hook pushes to the same ring, keep it out while this
+    // record is written so each ring still only has one producer at a time
+    taskENTER_CRITICAL();
+    trace_push(type, task);
+    taskEXIT_CRITICAL();
+}
+
+static uint8_t trace_chunk[TRACE_CHUNK_BYTES];
+static uint32_t trace_chunk_length;
+#if defined PLATFORM_QEMU
+static int32_t trace_file = -1;
+static bool trace_file_failed;
+#endif
+
+// The console may not pass raw bytes through untouched, so there the trace
+// goes out as hex between the TRACE markers
+static void trace_print_hex(const uint8_t* bytes, uint32_t length)
+{
+    static const char digits[] = "0123456789abcdef";
+    char text[TRACE_LINE_BYTES * 2 + 1];
+
+    for(uint32_t offset = 0; offset < length; offset += TRACE_LINE_BYTES)
+    {
+        uint32_t count = length - offset < TRACE_LINE_BYTES ? length - offset : TRACE_LINE_BYTES;
+
+        for(uint32_t i = 0; i < count; ++i)
+        {
+            text[i * 2] = digits[bytes[offset + i] >> 4];
+            text[i * 2 + 1] = digits[bytes[offset + i] & 0xf];
+        }
+        text[count * 2] = '\0';
+
+        printf("%s\n", text);
+    }
+}
+
+static void trace_flush(void)
+{
+    if(trace_chunk_length == 0)
+        return;
+
+#if defined PLATFORM_QEMU
+    if(trace_file >= 0)
+    {
+        // The whole chunk is handed to the host at once
+        if(semihosting_write(trace_file, trace_chunk, trace_chunk_length) != 0)
+            trace_file_failed = true;
+    }
+    else
+#endif
+    {
+        trace_print_hex(trace_chunk, trace_chunk_length);
+    }
+
+    trace_chunk_length = 0;
+}
+
+static void trace_write(const void* data, uint32_t length)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+
+    while(length != 0)
+    {
+        uint32_t count = TRACE_CHUNK_BYTES - trace_chunk_length;
+        if(count > length)
+            count = length;
+
+        memcpy(&trace_chunk[trace_chunk_length], bytes, count);
+        trace_chunk_length += count;
+        bytes += count;
+        length -= count;
+
+        if(trace_chunk_length == TRACE_CHUNK_BYTES)
+            trace_flush();
+    }
+}
+
+void trace_dump(void)
+{
+    TraceHeader header;
+    uint32_t tails[configNUMBER_OF_CORES];
+    uint32_t heads[configNUMBER_OF_CORES];
+
+    memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_FORMAT_VERSION;
+    header.record_size = sizeof(TraceRecord);
+    header.time_frequency_hz = (uint32_t)(get_time_frequency_ms() * 1000);
+    header.cores = configNUMBER_OF_CORES;
+    header.name_length = configMAX_TASK_NAME_LEN;
+    header.name_count = next_task_number < TRACE_MAX_TASKS ? next_task_number : TRACE_MAX_TASKS;
+    header.record_count = 0;
+    header.dropped = 0;
+
+    // Only what is in the rings now is dumped, records pushed while dumping
+    // are left for the next dump
+    for(uint32_t core = 0; core < configNUMBER_OF_CORES; ++core)
+    {
+        tails[core] = atomic_load_explicit(&rings[core].tail, memory_order_relaxed);
+        heads[core] = atomic_load_explicit(&rings[core].head, memory_order_acquire);
+        header.record_count += heads[core] - tails[core];
+        header.dropped += rings[core].dropped;
+    }
+
+#if defined PLATFORM_QEMU
+    trace_file = semihosting_open(TRACE_FILE, SEMIHOSTING_MODE_WB);
+    trace_file_failed = false;
+    if(trace_file < 0)
+#endif
+    {
+        printf("---TRACE START---\n");
+    }
+
+    trace_write(&header, sizeof(header));
+    trace_write(task_names, header.name_count * configMAX_TASK_NAME_LEN);
+
+    // Each ring is in time order already, merge them so the whole trace is
+    for(;;)
+    {
+        TraceRecord* next = NULL;
+        uint32_t next_core = 0;
+
+        for(uint32_t core = 0; core < configNUMBER_OF_CORES; ++core)
+        {
+            if(tails[core] == heads[core])
+                continue;
+
+            TraceRecord* record = &rings[core].records[tails[core] & TRACE_BUFFER_MASK];
+            if(next == NULL || record->time < next->time)
+            {
+                next = record;
+                next_core = core;
+            }
+        }
+
+        if(next == NULL)
+            break;
+
+        trace_write(next, sizeof(*next));
+        tails[next_core]++;
+    }
+    trace_flush();
+
+#if defined PLATFORM_QEMU
+    if(trace_file >= 0)
+    {
+        semihosting_close(trace_file);
+        trace_file = -1;
+
+        if(trace_file_failed)
+            printf("Could not write all of the trace to %s\n", TRACE_FILE);
+        else
+            printf("Trace of %d records written to %s\n", header.record_count, TRACE_FILE);
+    }
+    else
+#endif
+    {
+        printf("----TRACE END----\n");
+    }
+
+    for(uint32_t core = 0; core < configNUMBER_OF_CORES; ++core)
+    {
+        atomic_store_explicit(&rings[core].tail, tails[core], memory_order_release);
+        rings[core].dropped = 0;
+    }
+}
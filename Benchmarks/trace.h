@@ -0,0 +1,63 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+// Records per core, must be a power of two. Long runs can be built with a
+// bigger one, such as -DTRACE_BUFFER_LENGTH=131072
+#ifndef TRACE_BUFFER_LENGTH
+#define TRACE_BUFFER_LENGTH 1024
+#endif
+// Task numbers at or above this are traced without a name
+#define TRACE_MAX_TASKS 64
+
+// The trace is dumped as a TraceHeader, header.name_count names of
+// header.name_length bytes each, indexed by task number, and then
+// header.record_count TraceRecords in time order. Everything is little endian.
+// Bump TRACE_FORMAT_VERSION whenever any of it changes, trace_format.py
+// decodes it.
+#define TRACE_MAGIC "FRTR"
+#define TRACE_FORMAT_VERSION 2
+
+typedef enum
+{
+    e_TraceTaskSwitchedIn,
+    e_TraceJobArrived,
+    e_TraceJobStarted,
+    e_TraceJobFinished
+} TraceEventType;
+
+typedef struct
+{
+    char magic[4];
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t time_frequency_hz; // Record times are in counts of get_current_time()
+    uint8_t cores;
+    uint8_t name_length;
+    uint16_t name_count;
+    uint32_t record_count;
+    uint32_t dropped;          // Records lost to full rings, over every core
+} TraceHeader;
+
+typedef struct
+{
+    uint64_t time;
+    uint16_t task;
+    uint8_t core;
+    uint8_t type;
+    uint32_t reserved;         // Pads the record to a multiple of the time's alignment
+} TraceRecord;
+
+_Static_assert(sizeof(TraceHeader) == 24, "TraceHeader must not have padding");
+_Static_assert(sizeof(TraceRecord) == 16, "TraceRecord must not have padding");
+
+// Only from the context switch hook
+void trace_push(TraceEventType type, TaskHandle_t task);
+// From tasks, or before the scheduler has started
+void trace_job(TraceEventType type, TaskHandle_t task);
+void trace_dump(void);
+
+#endif
@@ -54,6 +54,20 @@
 #define TICK_TYPE_WIDTH_32_BITS    1
 #define TICK_TYPE_WIDTH_64_BITS    2
 
+/* Acceptable values for configEDF_PARTITION_HEURISTIC. */
+#define EDF_PARTITION_FIRST_FIT    0
+#define EDF_PARTITION_WORST_FIT    1
+
+/* Acceptable values for configEDF_DEADLINE_MISS_POLICY. */
+#define EDF_DEADLINE_MISS_COUNT     0
+#define EDF_DEADLINE_MISS_ABORT     1
+#define EDF_DEADLINE_MISS_DEMOTE    2
+#define EDF_DEADLINE_MISS_HOOK      3
+
+/* Acceptable values for configADMISSION_CONTROL. */
+#define ADMISSION_CONTROL_FLAG      0
+#define ADMISSION_CONTROL_REJECT    1
+
 /* Application specific configuration options. */
 #include "FreeRTOSConfig.h"
 
@@ -512,12 +526,137 @@
     #define configUSE_PASSIVE_IDLE_HOOK    0
 #endif /* configUSE_PASSIVE_IDLE_HOOK */
 
+/* Set configEDF_USE_READY_HEAP to 1 to keep ready tasks in a binary heap
+ * ordered by deadline instead of a sorted list.  The heap holds at most
+ * configEDF_READY_HEAP_LENGTH ready tasks (idle tasks are not counted). */
+#ifndef configEDF_USE_READY_HEAP
+    #define configEDF_USE_READY_HEAP    0
+#endif /* configEDF_USE_READY_HEAP */
+
+#if ( configEDF_USE_READY_HEAP == 1 )
+    #ifndef configEDF_READY_HEAP_LENGTH
+        #error If configEDF_USE_READY_HEAP is set to 1 then configEDF_READY_HEAP_LENGTH must also be defined.
+    #endif /* configEDF_READY_HEAP_LENGTH */
+#endif
+
+/* Global EDF runs the configNUMBER_OF_CORES earliest deadline tasks at once,
+ * there is no priority level to restrict it to. */
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configRUN_MULTIPLE_PRIORITIES == 0 ) )
+    #error configRUN_MULTIPLE_PRIORITIES must be set to 1 for the EDF scheduler to use more than one core
+#endif
+
+/* Set configEDF_PARTITIONED to 1 to run partitioned EDF rather than global
+ * EDF on more than one core.  Every task with a deadline is assigned to one of
+ * the cores its affinity mask allows, using configEDF_PARTITION_HEURISTIC, and
+ * each core has its own ready queue.  The ready tasks created before the
+ * scheduler starts are assigned in order of decreasing utilization. */
+#ifndef configEDF_PARTITIONED
+    #define configEDF_PARTITIONED    0
+#endif
+
+#ifndef configEDF_PARTITION_HEURISTIC
+    #define configEDF_PARTITION_HEURISTIC    EDF_PARTITION_FIRST_FIT
+#endif
+
+#if ( configEDF_PARTITIONED == 1 )
+    #if ( configNUMBER_OF_CORES == 1 )
+        #error configEDF_PARTITIONED can only be used with more than one core
+    #endif
+
+    #if ( configUSE_CORE_AFFINITY == 0 )
+        #error configUSE_CORE_AFFINITY must be set to 1 to use configEDF_PARTITIONED
+    #endif
+
+    #if ( ( configEDF_PARTITION_HEURISTIC != EDF_PARTITION_FIRST_FIT ) && ( configEDF_PARTITION_HEURISTIC != EDF_PARTITION_WORST_FIT ) )
+        #error configEDF_PARTITION_HEURISTIC must be EDF_PARTITION_FIRST_FIT or EDF_PARTITION_WORST_FIT
+    #endif
+#endif /* configEDF_PARTITIONED */
+
+/* What the tick interrupt does when the job with the earliest deadline has
+ * passed it.  The miss is always counted, see TaskStatus_t.
+ * EDF_DEADLINE_MISS_COUNT - the job carries on.
+ * EDF_DEADLINE_MISS_ABORT - a periodic task is blocked until its next release
+ * that is still to come, and carries on from where it was as that job.  A task
+ * that is not periodic is demoted.
+ * EDF_DEADLINE_MISS_DEMOTE - the job is moved behind every other deadline until
+ * the task starts its next job.
+ * EDF_DEADLINE_MISS_HOOK - vApplicationDeadlineMissedHook() is called from the
+ * tick interrupt, and the job carries on. */
+#ifndef configEDF_DEADLINE_MISS_POLICY
+    #define configEDF_DEADLINE_MISS_POLICY    EDF_DEADLINE_MISS_COUNT
+#endif
+
+#if ( ( configEDF_DEADLINE_MISS_POLICY < EDF_DEADLINE_MISS_COUNT ) || ( configEDF_DEADLINE_MISS_POLICY > EDF_DEADLINE_MISS_HOOK ) )
+    #error configEDF_DEADLINE_MISS_POLICY must be EDF_DEADLINE_MISS_COUNT, EDF_DEADLINE_MISS_ABORT, EDF_DEADLINE_MISS_DEMOTE or EDF_DEADLINE_MISS_HOOK
+#endif
+
+/* Periodic tasks are admitted while the sum of their densities (the worst case
+ * execution time over the smaller of the deadline and the period) stays within
+ * what EDF can schedule, one core per ready queue.  A task that does not fit is
+ * passed to traceTASK_ADMISSION_FAILED().  With ADMISSION_CONTROL_FLAG it is
+ * still created, with ADMISSION_CONTROL_REJECT it is not. */
+#ifndef configADMISSION_CONTROL
+    #define configADMISSION_CONTROL    ADMISSION_CONTROL_FLAG
+#endif
+
+#if ( ( configADMISSION_CONTROL != ADMISSION_CONTROL_FLAG ) && ( configADMISSION_CONTROL != ADMISSION_CONTROL_REJECT ) )
+    #error configADMISSION_CONTROL must be ADMISSION_CONTROL_FLAG or ADMISSION_CONTROL_REJECT
+#endif
+
+/* Set configEDF_USE_SERVERS to 1 to include constant bandwidth servers.  A
+ * server reserves a budget of execution time every period, and the aperiodic
+ * tasks attached to it with vTaskSetServer() share that budget without being
+ * able to take more of the processor than it reserves. */
+#ifndef configEDF_USE_SERVERS
+    #define configEDF_USE_SERVERS    0
+#endif
+
+/* Mutexes follow the Stack Resource Policy, with a preemption ceiling given to
+ * each mutex by vSemaphoreSetCeiling().  The policy is only implemented for a
+ * single core. */
+#if ( ( configUSE_MUTEXES == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+    #error configUSE_MUTEXES can only be used with the EDF scheduler on a single core
+#endif
+
 /* The timers module relies on xTaskGetSchedulerState(). */
 #if configUSE_TIMERS == 1
 
-    #ifndef configTIMER_TASK_PRIORITY
-        #error If configUSE_TIMERS is set to 1 then configTIMER_TASK_PRIORITY must also be defined.
-    #endif /* configTIMER_TASK_PRIORITY */
+/* The timer service task has no priority under EDF.  It is not periodic, so
+ * each time it is woken to process expired timers or commands it starts a job
+ * due configTIMER_TASK_DEADLINE ticks later.  A configuration written for the
+ * priority scheduler only gives configTIMER_TASK_PRIORITY, which is then taken
+ * as the deadline. */
+    #ifndef configTIMER_TASK_DEADLINE
+        #ifdef configTIMER_TASK_PRIORITY
+            #define configTIMER_TASK_DEADLINE    configTIMER_TASK_PRIORITY
+        #else
+            #error If configUSE_TIMERS is set to 1 then configTIMER_TASK_DEADLINE must also be defined.
+        #endif
+    #endif /* configTIMER_TASK_DEADLINE */
+
+/* Set configTIMER_TASK_SERVER_BUDGET to more than 0 to run the timer service
+ * task in a constant bandwidth server of that budget every
+ * configTIMER_TASK_SERVER_PERIOD ticks, created when the scheduler starts.  The
+ * task then takes the deadline of the server instead of
+ * configTIMER_TASK_DEADLINE, and a burst of timer callbacks cannot take more of
+ * the processor than the server reserves. */
+    #ifndef configTIMER_TASK_SERVER_BUDGET
+        #define configTIMER_TASK_SERVER_BUDGET    0
+    #endif
+
+    #if ( configTIMER_TASK_SERVER_BUDGET > 0 )
+        #if ( configEDF_USE_SERVERS == 0 )
+            #error configEDF_USE_SERVERS must be set to 1 to use configTIMER_TASK_SERVER_BUDGET
+        #endif
+
+        #ifndef configTIMER_TASK_SERVER_PERIOD
+            #error If configTIMER_TASK_SERVER_BUDGET is more than 0 then configTIMER_TASK_SERVER_PERIOD must also be defined.
+        #endif
+
+        #if ( configTIMER_TASK_SERVER_BUDGET > configTIMER_TASK_SERVER_PERIOD )
+            #error configTIMER_TASK_SERVER_BUDGET must be no more than configTIMER_TASK_SERVER_PERIOD
+        #endif
+    #endif /* configTIMER_TASK_SERVER_BUDGET */
 
     #ifndef configTIMER_QUEUE_LENGTH
         #error If configUSE_TIMERS is set to 1 then configTIMER_QUEUE_LENGTH must also be defined.
@@ -832,6 +971,26 @@
     #define traceTASK_CREATE_FAILED()
 #endif
 
+#ifndef traceTASK_ADMISSION_FAILED
+    #define traceTASK_ADMISSION_FAILED( pxNewTCB )
+#endif
+
+#ifndef traceTASK_DEADLINE_MISSED
+    #define traceTASK_DEADLINE_MISSED( pxTCB )
+#endif
+
+#ifndef traceSERVER_CREATE
+    #define traceSERVER_CREATE( pxNewServer )
+#endif
+
+#ifndef traceSERVER_ADMISSION_FAILED
+    #define traceSERVER_ADMISSION_FAILED( pxNewServer )
+#endif
+
+#ifndef traceSERVER_BUDGET_EXHAUSTED
+    #define traceSERVER_BUDGET_EXHAUSTED( pxServer )
+#endif
+
 #ifndef traceTASK_DELETE
     #define traceTASK_DELETE( pxTaskToDelete )
 #endif
@@ -1228,6 +1387,14 @@
     #define traceRETURN_xQueueGetMutexHolderFromISR( pxReturn )
 #endif
 
+#ifndef traceENTER_vQueueSetMutexCeiling
+    #define traceENTER_vQueueSetMutexCeiling( xMutex, xCeiling )
+#endif
+
+#ifndef traceRETURN_vQueueSetMutexCeiling
+    #define traceRETURN_vQueueSetMutexCeiling()
+#endif
+
 #ifndef traceENTER_xQueueGiveMutexRecursive
     #define traceENTER_xQueueGiveMutexRecursive( xMutex )
 #endif
@@ -1692,6 +1859,14 @@
     #define traceRETURN_xTaskCreateStatic( xReturn )
 #endif
 
+#ifndef traceENTER_xTaskCreatePeriodicStatic
+    #define traceENTER_xTaskCreatePeriodicStatic( pxTaskCode, pcName, uxStackDepth, pvParameters, xPeriod, xRelativeDeadline, xWorstCaseExecutionTime, puxStackBuffer, pxTaskBuffer )
+#endif
+
+#ifndef traceRETURN_xTaskCreatePeriodicStatic
+    #define traceRETURN_xTaskCreatePeriodicStatic( xReturn )
+#endif
+
 #ifndef traceENTER_xTaskCreateStaticAffinitySet
     #define traceENTER_xTaskCreateStaticAffinitySet( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, puxStackBuffer, pxTaskBuffer, uxCoreAffinityMask )
 #endif
@@ -1740,6 +1915,14 @@
     #define traceRETURN_xTaskCreate( xReturn )
 #endif
 
+#ifndef traceENTER_xTaskCreatePeriodic
+    #define traceENTER_xTaskCreatePeriodic( pxTaskCode, pcName, uxStackDepth, pvParameters, xPeriod, xRelativeDeadline, xWorstCaseExecutionTime, pxCreatedTask )
+#endif
+
+#ifndef traceRETURN_xTaskCreatePeriodic
+    #define traceRETURN_xTaskCreatePeriodic( xReturn )
+#endif
+
 #ifndef traceENTER_xTaskCreateAffinitySet
     #define traceENTER_xTaskCreateAffinitySet( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, uxCoreAffinityMask, pxCreatedTask )
 #endif
@@ -1772,6 +1955,46 @@
     #define traceRETURN_vTaskDelay()
 #endif
 
+#ifndef traceENTER_vTaskWaitForNextPeriod
+    #define traceENTER_vTaskWaitForNextPeriod()
+#endif
+
+#ifndef traceRETURN_vTaskWaitForNextPeriod
+    #define traceRETURN_vTaskWaitForNextPeriod()
+#endif
+
+#ifndef traceENTER_lTaskGetAdmissionHeadroom
+    #define traceENTER_lTaskGetAdmissionHeadroom( xCoreID )
+#endif
+
+#ifndef traceRETURN_lTaskGetAdmissionHeadroom
+    #define traceRETURN_lTaskGetAdmissionHeadroom( lHeadroom )
+#endif
+
+#ifndef traceENTER_xTaskCreateServerStatic
+    #define traceENTER_xTaskCreateServerStatic( xBudget, xPeriod, pxServerBuffer )
+#endif
+
+#ifndef traceRETURN_xTaskCreateServerStatic
+    #define traceRETURN_xTaskCreateServerStatic( xReturn )
+#endif
+
+#ifndef traceENTER_xTaskCreateServer
+    #define traceENTER_xTaskCreateServer( xBudget, xPeriod )
+#endif
+
+#ifndef traceRETURN_xTaskCreateServer
+    #define traceRETURN_xTaskCreateServer( xReturn )
+#endif
+
+#ifndef traceENTER_vTaskSetServer
+    #define traceENTER_vTaskSetServer( xTask, xServer )
+#endif
+
+#ifndef traceRETURN_vTaskSetServer
+    #define traceRETURN_vTaskSetServer()
+#endif
+
 #ifndef traceENTER_eTaskGetState
     #define traceENTER_eTaskGetState( xTask )
 #endif
@@ -2248,6 +2471,22 @@
     #define traceRETURN_vTaskPriorityDisinheritAfterTimeout()
 #endif
 
+#ifndef traceENTER_xTaskRaiseSystemCeiling
+    #define traceENTER_xTaskRaiseSystemCeiling( xCeiling )
+#endif
+
+#ifndef traceRETURN_xTaskRaiseSystemCeiling
+    #define traceRETURN_xTaskRaiseSystemCeiling( xPreviousCeiling )
+#endif
+
+#ifndef traceENTER_xTaskRestoreSystemCeiling
+    #define traceENTER_xTaskRestoreSystemCeiling( xPreviousCeiling )
+#endif
+
+#ifndef traceRETURN_xTaskRestoreSystemCeiling
+    #define traceRETURN_xTaskRestoreSystemCeiling( xReturn )
+#endif
+
 #ifndef traceENTER_vTaskYieldWithinAPI
     #define traceENTER_vTaskYieldWithinAPI()
 #endif
@@ -3172,6 +3411,18 @@ typedef struct xSTATIC_TCB
     #endif
     StaticListItem_t xDummy3[ 2 ];
     TickType_t uxDummy27;
+    TickType_t xDummy29[ 4 ];
+    UBaseType_t uxDummy31;
+    BaseType_t xDummy32;
+    #if ( configEDF_USE_READY_HEAP == 1 )
+        UBaseType_t uxDummy28;
+    #endif
+    #if ( configEDF_PARTITIONED == 1 )
+        BaseType_t xDummy30;
+    #endif
+    #if ( configEDF_USE_SERVERS == 1 )
+        void * pvDummy33[ 2 ];
+    #endif
     UBaseType_t uxDummy5;
     void * pxDummy6;
     #if ( configNUMBER_OF_CORES > 1 )
@@ -3222,6 +3473,25 @@ typedef struct xSTATIC_TCB
     #endif
 } StaticTask_t;
 
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real structure used to hold a constant bandwidth
+ * server is not accessible to the application code.  However, if the
+ * application writer wants to statically allocate a server then the size of the
+ * server object needs to be known.  Its size and alignment requirements are
+ * guaranteed to match those of the genuine structure, no matter which
+ * architecture is being used, and no matter how the values in FreeRTOSConfig.h
+ * are set.
+ */
+typedef struct xSTATIC_TASK_SERVER
+{
+    TickType_t xDummy1[ 4 ];
+    void * pvDummy2;
+    #if ( configEDF_PARTITIONED == 1 )
+        BaseType_t xDummy3;
+    #endif
+} StaticTaskServer_t;
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -3262,6 +3532,10 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_MUTEXES == 1 )
+        TickType_t xDummy10[ 2 ];
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1521,6 +1521,15 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
     TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
 #endif
 
+/*
+ * For internal use only.  Use vSemaphoreSetCeiling() instead of calling this
+ * function directly.
+ */
+#if ( configUSE_MUTEXES == 1 )
+    void vQueueSetMutexCeiling( QueueHandle_t xMutex,
+                                TickType_t xCeiling ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * For internal use only.  Use xSemaphoreTakeRecursive() or
  * xSemaphoreGiveRecursive() instead of calling these functions directly.
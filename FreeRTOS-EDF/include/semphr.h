@@ -1162,6 +1162,39 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreGetMutexHolderFromISR( xSemaphore )    xQueueGetMutexHolderFromISR( ( xSemaphore ) )
 #endif
 
+/**
+ * semphr.h
+ * @code{c}
+ * void vSemaphoreSetCeiling( SemaphoreHandle_t xMutex, TickType_t xCeiling );
+ * @endcode
+ *
+ * Set the preemption ceiling of a mutex or recursive mutex, which is the
+ * shortest relative deadline of the tasks that take it.
+ *
+ * Mutexes follow the Stack Resource Policy.  While a mutex is held, a task
+ * that does not hold a mutex can only start running if its relative deadline
+ * is shorter than the ceiling of every mutex that is held.  A task therefore
+ * never finds a mutex it takes already held, nothing has to be inherited, and
+ * a job is held up by at most one critical section of a task with a longer
+ * relative deadline.  Mutexes must be given back in the reverse order to the
+ * one they were taken in, and a task must not block while holding one.
+ *
+ * A new mutex has a ceiling of 0, so no task with a deadline can preempt its
+ * holder.  Setting the ceiling lets the tasks that do not use the mutex
+ * preempt the holder.
+ *
+ * @param xMutex A handle to the mutex.
+ *
+ * @param xCeiling The shortest relative deadline, in ticks, of the tasks that
+ * take the mutex.
+ *
+ * \defgroup vSemaphoreSetCeiling vSemaphoreSetCeiling
+ * \ingroup Semaphores
+ */
+#if ( configUSE_MUTEXES == 1 )
+    #define vSemaphoreSetCeiling( xMutex, xCeiling )    vQueueSetMutexCeiling( ( QueueHandle_t ) ( xMutex ), ( xCeiling ) )
+#endif
+
 /**
  * semphr.h
  * @code{c}
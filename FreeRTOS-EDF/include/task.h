@@ -95,6 +95,18 @@ struct tskTaskControlBlock; /* The old naming convention is used to prevent brea
 typedef struct tskTaskControlBlock         * TaskHandle_t;
 typedef const struct tskTaskControlBlock   * ConstTaskHandle_t;
 
+/**
+ * task. h
+ *
+ * Type by which constant bandwidth servers are referenced, see
+ * xTaskCreateServer().
+ *
+ * \defgroup TaskServerHandle_t TaskServerHandle_t
+ * \ingroup Tasks
+ */
+struct tskTaskServer;
+typedef struct tskTaskServer * TaskServerHandle_t;
+
 /*
  * Defines the prototype to which the application task hook function must
  * conform.
@@ -175,6 +187,7 @@ typedef struct xTASK_STATUS
         StackType_t * pxEndOfStack;               /* Points to the end address of the task's stack area. */
     #endif
     configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
+    UBaseType_t uxDeadlineMisses;                 /* The number of jobs of the task that have missed their deadline, see configEDF_DEADLINE_MISS_POLICY. */
     #if ( ( configUSE_CORE_AFFINITY == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
         UBaseType_t uxCoreAffinityMask;           /* The core affinity mask for the task */
     #endif
@@ -205,6 +218,14 @@ typedef enum
  */
 #define tskNO_AFFINITY      ( ( UBaseType_t ) -1 )
 
+/**
+ * The density of a task that needs the whole of a core, see
+ * lTaskGetAdmissionHeadroom().
+ *
+ * \ingroup TaskUtils
+ */
+#define tskUTILIZATION_ONE    ( ( int32_t ) 10000 )
+
 /**
  * task. h
  *
@@ -439,7 +460,11 @@ typedef enum
  * @param pvParameters Pointer that will be used as the parameter for the task
  * being created.
  *
- * @param uxPriority The priority at which the task will run.
+ * @param uxDeadline The deadline of the task in ticks, relative to each time
+ * it is released.  The task is released when it is created and each time it
+ * leaves the Blocked or Suspended state, and runs in order of the absolute
+ * deadline of that release.  portMAX_DELAY creates a task that only runs when
+ * no task with a deadline is ready.
  *
  * @param puxStackBuffer Must point to a StackType_t array that has at least
  * uxStackDepth indexes - the array will then be used as the task's stack,
@@ -518,6 +543,98 @@ typedef enum
                                     StaticTask_t * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskCreatePeriodic(
+ *                            TaskFunction_t pxTaskCode,
+ *                            const char * const pcName,
+ *                            const configSTACK_DEPTH_TYPE uxStackDepth,
+ *                            void *pvParameters,
+ *                            TickType_t xPeriod,
+ *                            TickType_t xRelativeDeadline,
+ *                            TickType_t xWorstCaseExecutionTime,
+ *                            TaskHandle_t *pxCreatedTask
+ *                        );
+ *
+ * TaskHandle_t xTaskCreatePeriodicStatic(
+ *                            TaskFunction_t pxTaskCode,
+ *                            const char * const pcName,
+ *                            const configSTACK_DEPTH_TYPE uxStackDepth,
+ *                            void *pvParameters,
+ *                            TickType_t xPeriod,
+ *                            TickType_t xRelativeDeadline,
+ *                            TickType_t xWorstCaseExecutionTime,
+ *                            StackType_t * const puxStackBuffer,
+ *                            StaticTask_t * const pxTaskBuffer
+ *                        );
+ * @endcode
+ *
+ * Create a periodic task.  The parameters are the same as xTaskCreate() and
+ * xTaskCreateStatic(), except the deadline is replaced by the timing of the
+ * task.
+ *
+ * The first job of the task is released when it is created.  Each following
+ * job is released xPeriod ticks after the one before it, when the task calls
+ * vTaskWaitForNextPeriod(), and has to finish within xRelativeDeadline ticks
+ * of its release.  The task keeps the same deadline if it blocks for any other
+ * reason part way through a job.
+ *
+ * @param xPeriod The time between releases in ticks.  Must be greater than 0.
+ *
+ * @param xRelativeDeadline The deadline of each job in ticks, relative to its
+ * release.  Must be greater than 0.
+ *
+ * @param xWorstCaseExecutionTime The worst case execution time of each job in
+ * ticks.  Recorded for use by the scheduler, it is not enforced.
+ *
+ * Example usage:
+ * @code{c}
+ *  // Runs every 10 ticks and has to finish within 5 ticks of each release.
+ *  void vControlLoop( void * pvParameters )
+ *  {
+ *      for( ;; )
+ *      {
+ *          // Sample inputs and update outputs here.
+ *
+ *          vTaskWaitForNextPeriod();
+ *      }
+ *  }
+ *
+ *  void vOtherFunction( void )
+ *  {
+ *      static StaticTask_t xTaskBuffer;
+ *      static StackType_t xStack[ STACK_SIZE ];
+ *
+ *      xTaskCreatePeriodicStatic( vControlLoop, "CTRL", STACK_SIZE, NULL, 10, 5, 2, xStack, &xTaskBuffer );
+ *  }
+ * @endcode
+ * \defgroup xTaskCreatePeriodic xTaskCreatePeriodic
+ * \ingroup Tasks
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    BaseType_t xTaskCreatePeriodic( TaskFunction_t pxTaskCode,
+                                    const char * const pcName,
+                                    const configSTACK_DEPTH_TYPE uxStackDepth,
+                                    void * const pvParameters,
+                                    TickType_t xPeriod,
+                                    TickType_t xRelativeDeadline,
+                                    TickType_t xWorstCaseExecutionTime,
+                                    TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    TaskHandle_t xTaskCreatePeriodicStatic( TaskFunction_t pxTaskCode,
+                                            const char * const pcName,
+                                            const configSTACK_DEPTH_TYPE uxStackDepth,
+                                            void * const pvParameters,
+                                            TickType_t xPeriod,
+                                            TickType_t xRelativeDeadline,
+                                            TickType_t xWorstCaseExecutionTime,
+                                            StackType_t * const puxStackBuffer,
+                                            StaticTask_t * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
     TaskHandle_t xTaskCreateStaticAffinitySet( TaskFunction_t pxTaskCode,
                                                const char * const pcName,
@@ -935,6 +1052,157 @@ BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
         ( void ) xTaskDelayUntil( ( pxPreviousWakeTime ), ( xTimeIncrement ) ); \
     } while( 0 )
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskWaitForNextPeriod( void );
+ * @endcode
+ *
+ * Ends the current job of a task created with xTaskCreatePeriodic() or
+ * xTaskCreatePeriodicStatic(), and blocks the task until its next job is
+ * released.  The next release is one period after the last one, so it does not
+ * drift with how long the job took.  The deadline of the next job is set
+ * relative to that release.
+ *
+ * If the job overran its period the next job has already been released, and
+ * the task carries on without blocking.
+ *
+ * \defgroup vTaskWaitForNextPeriod vTaskWaitForNextPeriod
+ * \ingroup TaskCtrl
+ */
+void vTaskWaitForNextPeriod( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * int32_t lTaskGetAdmissionHeadroom( BaseType_t xCoreID );
+ * @endcode
+ *
+ * Returns how much more density the scheduler can admit, in units where
+ * tskUTILIZATION_ONE is the whole of one core.  A periodic task has a density
+ * of its worst case execution time over the smaller of its deadline and its
+ * period, and is admitted if its density is no more than the headroom.
+ *
+ * The result is negative if tasks have been created past the bound with
+ * configADMISSION_CONTROL set to ADMISSION_CONTROL_FLAG.
+ *
+ * @param xCoreID The core to query when configEDF_PARTITIONED is 1.  Otherwise
+ * it is not used, and the headroom of all the cores together is returned.
+ *
+ * Example usage:
+ * @code{c}
+ *  // Create the task only if it can meet its deadlines.
+ *  if( lTaskGetAdmissionHeadroom( 0 ) >= ( 2 * tskUTILIZATION_ONE ) / 10 )
+ *  {
+ *      xTaskCreatePeriodic( vControlLoop, "CTRL", STACK_SIZE, NULL, 10, 10, 2, NULL );
+ *  }
+ * @endcode
+ * \defgroup lTaskGetAdmissionHeadroom lTaskGetAdmissionHeadroom
+ * \ingroup TaskCtrl
+ */
+int32_t lTaskGetAdmissionHeadroom( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * TaskServerHandle_t xTaskCreateServer( TickType_t xBudget, TickType_t xPeriod );
+ *
+ * TaskServerHandle_t xTaskCreateServerStatic( TickType_t xBudget,
+ *                                             TickType_t xPeriod,
+ *                                             StaticTaskServer_t * pxServerBuffer );
+ * @endcode
+ *
+ * configEDF_USE_SERVERS must be set to 1 in FreeRTOSConfig.h for these
+ * functions to be available.
+ *
+ * Create a constant bandwidth server, which reserves xBudget ticks of
+ * execution time every xPeriod ticks for the aperiodic tasks attached to it
+ * with vTaskSetServer().  The server is admitted like a periodic task with the
+ * same worst case execution time and period.
+ *
+ * The tasks attached to a server are scheduled with the deadline of the
+ * server.  Each tick one of them runs for is taken from the budget.  Once the
+ * budget runs out it is refilled and the deadline of the server is moved one
+ * period later, so the tasks can carry on but no longer hold up the tasks
+ * that have an earlier deadline.  A server that has been idle starts again
+ * with a full budget and a deadline one period away, unless what is left of
+ * its budget can still be used by its current deadline without going over its
+ * bandwidth.
+ *
+ * Servers cannot be deleted.
+ *
+ * @param xBudget The execution time reserved every period in ticks.  Must be
+ * greater than 0 and no more than xPeriod.
+ *
+ * @param xPeriod The period of the server in ticks.
+ *
+ * @param pxServerBuffer Must point to a StaticTaskServer_t variable, which is
+ * used to hold the state of the server.
+ *
+ * @return The handle of the server, or NULL if the memory for it could not be
+ * allocated, or it was not admitted with configADMISSION_CONTROL set to
+ * ADMISSION_CONTROL_REJECT.
+ *
+ * Example usage:
+ * @code{c}
+ *  // Give the logging task 2 ticks in every 20, however much it has to do.
+ *  void vOtherFunction( TaskHandle_t xLoggingTask )
+ *  {
+ *      TaskServerHandle_t xServer;
+ *
+ *      xServer = xTaskCreateServer( 2, 20 );
+ *
+ *      if( xServer != NULL )
+ *      {
+ *          vTaskSetServer( xLoggingTask, xServer );
+ *      }
+ *  }
+ * @endcode
+ * \defgroup xTaskCreateServer xTaskCreateServer
+ * \ingroup Tasks
+ */
+#if ( ( configEDF_USE_SERVERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    TaskServerHandle_t xTaskCreateServer( TickType_t xBudget,
+                                          TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configEDF_USE_SERVERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    TaskServerHandle_t xTaskCreateServerStatic( TickType_t xBudget,
+                                                TickType_t xPeriod,
+                                                StaticTaskServer_t * const pxServerBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetServer( TaskHandle_t xTask, TaskServerHandle_t xServer );
+ * @endcode
+ *
+ * configEDF_USE_SERVERS must be set to 1 in FreeRTOSConfig.h for this function
+ * to be available.
+ *
+ * Attach a task to a constant bandwidth server, see xTaskCreateServer().  From
+ * then on the task runs within the budget of the server, with its deadline.  A
+ * task created without a deadline is scheduled with the deadline of the server
+ * too.  More than one task can be attached to the same server, they share its
+ * budget.
+ *
+ * The task must not be periodic, and must not already be attached to a server.
+ * With configEDF_PARTITIONED set to 1 the task is moved to the core the server
+ * was assigned to, whatever its affinity.
+ *
+ * @param xTask The handle of the task.  Passing NULL attaches the calling task.
+ *
+ * @param xServer The handle of the server.
+ *
+ * \defgroup vTaskSetServer vTaskSetServer
+ * \ingroup TaskCtrl
+ */
+#if ( configEDF_USE_SERVERS == 1 )
+    void vTaskSetServer( TaskHandle_t xTask,
+                         TaskServerHandle_t xServer ) PRIVILEGED_FUNCTION;
+#endif
+
 
 /**
  * task. h
@@ -1986,6 +2254,27 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION;
 
 #endif
 
+#if ( configEDF_DEADLINE_MISS_POLICY == EDF_DEADLINE_MISS_HOOK )
+
+/**
+ *  task.h
+ * @code{c}
+ * void vApplicationDeadlineMissedHook( TaskHandle_t xTask );
+ * @endcode
+ *
+ * This hook function is called from the tick interrupt when the job with the
+ * earliest deadline has passed it.  It is called once for each job that misses
+ * its deadline, and must only use the API functions that end in FromISR.
+ *
+ * @param xTask The task that missed its deadline.
+ */
+    /* MISRA Ref 8.6.1 [External linkage] */
+    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-86 */
+    /* coverity[misra_c_2012_rule_8_6_violation] */
+    void vApplicationDeadlineMissedHook( TaskHandle_t xTask );
+
+#endif
+
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 
 /**
@@ -3510,21 +3799,22 @@ BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
  * on the list of tasks waiting for a particular event, and the
  * list of delayed tasks.  The task will be removed from both lists
  * and replaced on the ready list should either the event occur (and
- * there be no higher priority tasks waiting on the same event) or
+ * there be no task with an earlier deadline waiting on the same event) or
  * the delay period expires.
  *
  * The 'unordered' version replaces the event list item value with the
  * xItemValue value, and inserts the list item at the end of the list.
  *
- * The 'ordered' version uses the existing event list item value (which is the
- * owning task's priority) to insert the list item into the event list in task
- * priority order.
+ * The 'ordered' version also inserts the list item at the end of the list,
+ * and xTaskRemoveFromEventList() picks the waiter by deadline when the event
+ * occurs.  The deadline a task gets when it is woken depends on when that is,
+ * so the order cannot be fixed when the task blocks.
  *
  * @param pxEventList The list containing tasks that are blocked waiting
  * for the event to occur.
  *
- * @param xItemValue The item value to use for the event list item when the
- * event list is not ordered by task priority.
+ * @param xItemValue The item value to use for the event list item of the
+ * unordered event list.
  *
  * @param xTicksToWait The maximum amount of time that the task should wait
  * for the event to occur.  This is specified in kernel ticks, the constant
@@ -3565,16 +3855,15 @@ void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
  * if either an event occurs to unblock a task, or the block timeout period
  * expires.
  *
- * xTaskRemoveFromEventList() is used when the event list is in task priority
- * order.  It removes the list item from the head of the event list as that will
- * have the highest priority owning task of all the tasks on the event list.
- * vTaskRemoveFromUnorderedEventList() is used when the event list is not
- * ordered and the event list items hold something other than the owning tasks
- * priority.  In this case the event list item value is updated to the value
- * passed in the xItemValue parameter.
+ * xTaskRemoveFromEventList() removes the task that would have the earliest
+ * deadline if released now, or the one that has waited longest of those with
+ * the same deadline.  A task without a deadline is only removed when no task
+ * with one is waiting.  vTaskRemoveFromUnorderedEventList() removes the given
+ * list item, and updates the event list item value to the value passed in the
+ * xItemValue parameter.
  *
- * @return pdTRUE if the task being removed has a higher priority than the task
- * making the call, otherwise pdFALSE.
+ * @return pdTRUE if the task being removed has to preempt the running task,
+ * otherwise pdFALSE.
  */
 BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
@@ -3623,28 +3912,28 @@ void vTaskMissedYield( void ) PRIVILEGED_FUNCTION;
 BaseType_t xTaskGetSchedulerState( void ) PRIVILEGED_FUNCTION;
 
 /*
- * Raises the priority of the mutex holder to that of the calling task should
- * the mutex holder have a priority less than the calling task.
+ * Kept for queue.c.  Mutexes follow the Stack Resource Policy, which needs no
+ * inheritance, so xTaskPriorityInherit() returns pdFALSE, and
+ * vTaskPriorityDisinheritAfterTimeout() does nothing.
+ * xTaskPriorityDisinherit() only counts the mutex as given back.
  */
 BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
-
-/*
- * Set the priority of a task back to its proper priority in the case that it
- * inherited a higher priority while it was holding a semaphore.
- */
 BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
-
-/*
- * If a higher priority task attempting to obtain a mutex caused a lower
- * priority task to inherit the higher priority task's priority - but the higher
- * priority task then timed out without obtaining the mutex, then the lower
- * priority task will disinherit the priority again - but only down as far as
- * the highest priority task that is still waiting for the mutex (if there were
- * more than one task waiting for the mutex).
- */
 void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
                                           UBaseType_t uxHighestPriorityWaitingTask ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  xTaskRaiseSystemCeiling() raises the system ceiling
+ * to xCeiling, if it is not already at least that high, when a mutex is taken
+ * and returns the ceiling from before.  xTaskRestoreSystemCeiling() puts that
+ * ceiling back when the mutex is given, and returns pdTRUE if that lets a task
+ * with an earlier deadline than the calling task run.
+ */
+#if ( configUSE_MUTEXES == 1 )
+    TickType_t xTaskRaiseSystemCeiling( TickType_t xCeiling ) PRIVILEGED_FUNCTION;
+    BaseType_t xTaskRestoreSystemCeiling( TickType_t xPreviousCeiling ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Get the uxTaskNumber assigned to the task referenced by the xTask parameter.
  */
@@ -133,6 +133,11 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_MUTEXES == 1 )
+        TickType_t xCeiling;         /**< The shortest relative deadline of the tasks that take the mutex, see vSemaphoreSetCeiling(). */
+        TickType_t xPreviousCeiling; /**< The system ceiling from before the mutex was taken, put back when it is given. */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -628,6 +633,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             /* In case this is a recursive mutex. */
             pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
+            /* Until vSemaphoreSetCeiling() says which tasks use the mutex its
+             * ceiling is above every task, so no task with a deadline can
+             * preempt the holder. */
+            pxNewQueue->xCeiling = ( TickType_t ) 0U;
+            pxNewQueue->xPreviousCeiling = portMAX_DELAY;
+
             traceCREATE_MUTEX( pxNewQueue );
 
             /* Start with the semaphore in the expected state. */
@@ -754,6 +765,28 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEXES == 1 )
+
+    void vQueueSetMutexCeiling( QueueHandle_t xMutex,
+                                TickType_t xCeiling )
+    {
+        Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+
+        traceENTER_vQueueSetMutexCeiling( xMutex, xCeiling );
+
+        configASSERT( pxMutex );
+        configASSERT( pxMutex->uxQueueType == queueQUEUE_IS_MUTEX );
+
+        /* The ceiling is read when the mutex is taken, so if the mutex is held
+         * the new ceiling applies from the next time it is taken. */
+        pxMutex->xCeiling = xCeiling;
+
+        traceRETURN_vQueueSetMutexCeiling();
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_RECURSIVE_MUTEXES == 1 )
 
     BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex )
@@ -1004,12 +1037,15 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                          * queue then unblock it now. */
                         if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            if( ( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE ) ||
+                                ( xYieldRequired != pdFALSE ) )
                             {
-                                /* The unblocked task has a priority higher than
-                                 * our own so yield immediately.  Yes it is ok to
-                                 * do this from within the critical section - the
-                                 * kernel takes care of that. */
+                                /* The unblocked task, or a task the system
+                                 * ceiling no longer keeps out, has an earlier
+                                 * deadline than our own so yield immediately.
+                                 * Yes it is ok to do this from within the
+                                 * critical section - the kernel takes care of
+                                 * that. */
                                 queueYIELD_IF_USING_PREEMPTION();
                             }
                             else
@@ -1019,10 +1055,9 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                         }
                         else if( xYieldRequired != pdFALSE )
                         {
-                            /* This path is a special case that will only get
-                             * executed if the task was holding multiple mutexes
-                             * and the mutexes were given back in an order that is
-                             * different to that in which they were taken. */
+                            /* Giving back a mutex lowered the system ceiling,
+                             * which lets a task with an earlier deadline than
+                             * our own start. */
                             queueYIELD_IF_USING_PREEMPTION();
                         }
                         else
@@ -1039,9 +1074,11 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                      * queue then unblock it now. */
                     if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        if( ( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE ) ||
+                            ( xYieldRequired != pdFALSE ) )
                         {
-                            /* The unblocked task has a priority higher than
+                            /* The unblocked task, or a task the system ceiling
+                             * no longer keeps out, has an earlier deadline than
                              * our own so yield immediately.  Yes it is ok to do
                              * this from within the critical section - the kernel
                              * takes care of that. */
@@ -1054,10 +1091,9 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                     }
                     else if( xYieldRequired != pdFALSE )
                     {
-                        /* This path is a special case that will only get
-                         * executed if the task was holding multiple mutexes and
-                         * the mutexes were given back in an order that is
-                         * different to that in which they were taken. */
+                        /* Giving back a mutex lowered the system ceiling, which
+                         * lets a task with an earlier deadline than our own
+                         * start. */
                         queueYIELD_IF_USING_PREEMPTION();
                     }
                     else
@@ -1701,9 +1737,19 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                 {
                     if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
                     {
-                        /* Record the information required to implement
-                         * priority inheritance should it become necessary. */
+                        /* Record the holder, and raise the system ceiling so
+                         * that no other task that takes the mutex can start
+                         * until it is given back. */
                         pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+                        if( pxQueue->u.xSemaphore.xMutexHolder != NULL )
+                        {
+                            pxQueue->xPreviousCeiling = xTaskRaiseSystemCeiling( pxQueue->xCeiling );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
                     else
                     {
@@ -2409,6 +2455,23 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
             {
                 /* The mutex is no longer being held. */
                 xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+
+                if( pxQueue->u.xSemaphore.xMutexHolder != NULL )
+                {
+                    if( xTaskRestoreSystemCeiling( pxQueue->xPreviousCeiling ) != pdFALSE )
+                    {
+                        xReturn = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
                 pxQueue->u.xSemaphore.xMutexHolder = NULL;
             }
             else
@@ -85,16 +85,16 @@
         portYIELD_WITHIN_API();                                  \
     } while( 0 )
 
-        #define taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB ) \
-    do {                                                        \
-        if( pxCurrentTCB->uxPriority < ( pxTCB )->uxPriority )  \
-        {                                                       \
-            portYIELD_WITHIN_API();                             \
-        }                                                       \
-        else                                                    \
-        {                                                       \
-            mtCOVERAGE_TEST_MARKER();                           \
-        }                                                       \
+        #define taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB )              \
+    do {                                                                     \
+        if( taskPREEMPTS_CURRENT_TASK( pxTCB ) != pdFALSE )                  \
+        {                                                                    \
+            portYIELD_WITHIN_API();                                          \
+        }                                                                    \
+        else                                                                 \
+        {                                                                    \
+            mtCOVERAGE_TEST_MARKER();                                        \
+        }                                                                    \
     } while( 0 )
 
     #else /* if ( configNUMBER_OF_CORES == 1 ) */
@@ -182,10 +182,14 @@
     #if ( configNUMBER_OF_CORES == 1 )
         #define taskSELECT_HIGHEST_PRIORITY_TASK()                                       \
     do {                                                                                 \
-        if ( listLIST_IS_EMPTY( pxReadyTaskList ) )                                      \
+        TCB_t * pxEarliestTCB = taskGET_EARLIEST_DEADLINE_TASK( 0U );                    \
+                                                                                         \
+        taskAPPLY_SYSTEM_CEILING( pxEarliestTCB );                                       \
+                                                                                         \
+        if( pxEarliestTCB == NULL )                                                      \
             listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &xIdleTaskList );                 \
         else                                                                             \
-            pxCurrentTCB = listGET_HEAD_ENTRY( pxReadyTaskList )->pvOwner;               \
+            pxCurrentTCB = pxEarliestTCB;                                                \
     } while( 0 ) /* taskSELECT_HIGHEST_PRIORITY_TASK */
     #else /* if ( configNUMBER_OF_CORES == 1 ) */
 
@@ -257,19 +261,248 @@
 
 /*-----------------------------------------------------------*/
 
+/* Partitioned EDF gives every core a ready queue of its own, holding the
+ * tasks assigned to that core.  Otherwise there is one ready queue that all the
+ * cores take tasks from. */
+#if ( configEDF_PARTITIONED == 1 )
+    #define taskREADY_QUEUE_COUNT        configNUMBER_OF_CORES
+    #define taskREADY_QUEUE( pxTCB )    ( ( UBaseType_t ) ( pxTCB )->xPartitionCoreID )
+#else
+    #define taskREADY_QUEUE_COUNT        1
+    #define taskREADY_QUEUE( pxTCB )    ( ( UBaseType_t ) 0U )
+#endif
+
+/* Utilization and density are held in fixed point, a task with a density of
+ * taskUTILIZATION_ONE needs the whole of a core. */
+#define taskUTILIZATION_ONE    ( ( uint32_t ) tskUTILIZATION_ONE )
+#define taskDENSITY_MAX        ( taskUTILIZATION_ONE * 100U )
+
+/* EDF can meet every deadline while the sum of the densities is no more than
+ * one core.  With partitioning that holds for each core, global EDF is given
+ * all of the cores (which is necessary, but not sufficient, for it to meet every
+ * deadline). */
+#if ( configEDF_PARTITIONED == 1 )
+    #define taskADMISSION_BOUND    taskUTILIZATION_ONE
+#else
+    #define taskADMISSION_BOUND    ( taskUTILIZATION_ONE * ( uint32_t ) configNUMBER_OF_CORES )
+#endif
+
+/* pxReadyTaskLists and pxOverflowReadyTaskLists are switched when the tick
+ * count overflows.  Any task still in a ready list has a deadline from before
+ * the overflow, so has missed it and must run before the tasks whose deadlines
+ * are after the overflow.  Those tasks are moved to the front of the new list
+ * in the order they were in.  In heap mode the heap orders the tasks itself so
+ * the lists are left alone. */
+#if ( configEDF_USE_READY_HEAP == 1 )
+    #define taskSWITCH_READY_LISTS()
+#else
+    #define taskSWITCH_READY_LISTS()                                                       \
+    do {                                                                                   \
+        List_t * pxTemp;                                                                   \
+        ListItem_t * pxMissedItem;                                                         \
+        UBaseType_t uxQueue;                                                               \
+                                                                                           \
+        for( uxQueue = 0U; uxQueue < ( UBaseType_t ) taskREADY_QUEUE_COUNT; uxQueue++ )    \
+        {                                                                                  \
+            while( listLIST_IS_EMPTY( pxReadyTaskLists[ uxQueue ] ) == pdFALSE )           \
+            {                                                                              \
+                pxMissedItem = listGET_HEAD_ENTRY( pxReadyTaskLists[ uxQueue ] );          \
+                listREMOVE_ITEM( pxMissedItem );                                           \
+                listSET_LIST_ITEM_VALUE( pxMissedItem, ( TickType_t ) 0U );                \
+                vListInsert( pxOverflowReadyTaskLists[ uxQueue ], pxMissedItem );          \
+            }                                                                              \
+                                                                                           \
+            pxTemp = pxReadyTaskLists[ uxQueue ];                                          \
+            pxReadyTaskLists[ uxQueue ] = pxOverflowReadyTaskLists[ uxQueue ];             \
+            pxOverflowReadyTaskLists[ uxQueue ] = pxTemp;                                  \
+        }                                                                                  \
+    } while( 0 )
+#endif /* configEDF_USE_READY_HEAP */
+
+/*-----------------------------------------------------------*/
+
+/* Tasks created with a deadline of portMAX_DELAY only run when no task with a
+ * deadline is ready.  They are kept in xIdleTaskList rather than the ready
+ * lists. */
+#define taskIS_BACKGROUND_TASK( pxTCB )    ( ( ( pxTCB )->xRelativeDeadline == portMAX_DELAY ) ? pdTRUE : pdFALSE )
+
+/* Evaluates to pdTRUE if the tick xA comes before the tick xB.  The tick count
+ * wraps, so this holds when xA is less than half the tick range behind xB. */
+#define taskTICK_IS_BEFORE( xA, xB )    ( ( ( TickType_t ) ( ( xA ) - ( xB ) ) > ( portMAX_DELAY >> 1 ) ) ? pdTRUE : pdFALSE )
+
+/* Evaluates to pdTRUE if the task pxA has to run before the task pxB. */
+#define taskDEADLINE_IS_EARLIER( pxA, pxB )                             \
+    ( ( taskIS_BACKGROUND_TASK( pxA ) != pdFALSE ) ? pdFALSE :          \
+      ( taskIS_BACKGROUND_TASK( pxB ) != pdFALSE ) ? pdTRUE :           \
+      taskTICK_IS_BEFORE( ( pxA )->uxDeadline, ( pxB )->uxDeadline ) )
+
+#if ( configUSE_MUTEXES == 1 )
+
+/* Mutexes follow the Stack Resource Policy.  The preemption level of a task is
+ * its relative deadline, a shorter one being a higher level, and the ceiling of
+ * a mutex is the shortest relative deadline of the tasks that take it.
+ * xSystemCeiling is the lowest ceiling of the mutexes that are held, or
+ * portMAX_DELAY when none are.  A task that does not hold a mutex only starts
+ * while its relative deadline is below the system ceiling, so every mutex it
+ * then takes is free, and a job waits for at most one critical section of a
+ * task with a longer relative deadline. */
+    #define taskPASSES_SYSTEM_CEILING( pxTCB ) \
+    ( ( ( ( pxTCB )->xRelativeDeadline < xSystemCeiling ) || ( ( pxTCB )->uxMutexesHeld != ( UBaseType_t ) 0U ) ) ? pdTRUE : pdFALSE )
+
+/* Replaces pxTCB, the earliest deadline ready task, with the task to run if
+ * the system ceiling keeps it from starting. */
+    #define taskAPPLY_SYSTEM_CEILING( pxTCB )                  \
+    do {                                                       \
+        if( xSystemCeiling != portMAX_DELAY )                  \
+        {                                                      \
+            ( pxTCB ) = prvSelectTaskUnderCeiling( ( pxTCB ) ); \
+        }                                                      \
+    } while( 0 )
+
+#else /* if ( configUSE_MUTEXES == 1 ) */
+
+    #define taskPASSES_SYSTEM_CEILING( pxTCB )    pdTRUE
+    #define taskAPPLY_SYSTEM_CEILING( pxTCB )
+
+#endif /* if ( configUSE_MUTEXES == 1 ) */
+
+/* Evaluates to pdTRUE if the ready task pxTCB has to preempt the running task
+ * on a single core. */
+#define taskPREEMPTS_CURRENT_TASK( pxTCB )                                   \
+    ( ( ( taskDEADLINE_IS_EARLIER( ( pxTCB ), pxCurrentTCB ) != pdFALSE ) && \
+        ( taskPASSES_SYSTEM_CEILING( pxTCB ) != pdFALSE ) ) ? pdTRUE : pdFALSE )
+
+/* Starts a new job of the task released at the tick xRelease, which is due
+ * its relative deadline after that. */
+#define taskSTART_JOB( pxTCB, xRelease )                                                \
+    do {                                                                                \
+        if( taskIS_BACKGROUND_TASK( pxTCB ) == pdFALSE )                                \
+        {                                                                               \
+            ( pxTCB )->xReleaseTime = ( xRelease );                                     \
+            ( pxTCB )->uxDeadline = ( xRelease ) + ( pxTCB )->xRelativeDeadline;        \
+            ( pxTCB )->xDeadlineMissed = pdFALSE;                                       \
+        }                                                                               \
+    } while( 0 )
+
+/* Called whenever a task moves from the Blocked or Suspended state, but not
+ * when a ready task is just being reordered.  A task that is not periodic
+ * starts a new job each time.  A periodic task only starts a new job in
+ * vTaskWaitForNextPeriod(), so blocking part way through a job does not move
+ * its deadline.  A task attached to a server takes its deadline from the
+ * server instead. */
+#if ( configEDF_USE_SERVERS == 1 )
+    #define taskRELEASE_JOB( pxTCB )                            \
+    do {                                                        \
+        if( ( pxTCB )->pxServer != NULL )                       \
+        {                                                       \
+            prvServerReleaseJob( pxTCB );                       \
+        }                                                       \
+        else if( ( pxTCB )->xPeriod == ( TickType_t ) 0U )      \
+        {                                                       \
+            taskSTART_JOB( ( pxTCB ), xTickCount );             \
+        }                                                       \
+        else                                                    \
+        {                                                       \
+            mtCOVERAGE_TEST_MARKER();                           \
+        }                                                       \
+    } while( 0 )
+#else
+    #define taskRELEASE_JOB( pxTCB )                        \
+    do {                                                    \
+        if( ( pxTCB )->xPeriod == ( TickType_t ) 0U )       \
+        {                                                   \
+            taskSTART_JOB( ( pxTCB ), xTickCount );         \
+        }                                                   \
+    } while( 0 )
+#endif /* configEDF_USE_SERVERS */
+
+#if ( configEDF_USE_READY_HEAP == 1 )
+
+/* The ready list only records which tasks are ready so that the list based
+ * kernel code keeps working, it is not kept in order.  The run order is held
+ * by pxReadyHeaps, which makes insert and remove O(log n) instead of the O(n)
+ * walk vListInsert() does. */
+    #define taskINSERT_INTO_READY_QUEUE( pxTCB )                                                            \
+    do {                                                                                                    \
+        listINSERT_END( pxReadyTaskLists[ taskREADY_QUEUE( pxTCB ) ], &( ( pxTCB )->xStateListItem ) );     \
+        prvReadyHeapInsert( pxTCB );                                                                        \
+    } while( 0 )
+
+/* Must be used wherever the xStateListItem of a task that might be ready is
+ * removed from its list.  Does nothing if the task is not in the heap. */
+    #define taskREMOVE_FROM_READY_QUEUE( pxTCB )         \
+    do {                                                 \
+        if( ( pxTCB )->uxReadyHeapIndex != 0U )          \
+        {                                                \
+            prvReadyHeapRemove( pxTCB );                 \
+        }                                                \
+    } while( 0 )
+
+    #define taskGET_EARLIEST_DEADLINE_TASK( uxQueue )    ( ( uxReadyHeapLengths[ ( uxQueue ) ] == 0U ) ? NULL : pxReadyHeaps[ ( uxQueue ) ][ 0 ] )
+
+#else /* configEDF_USE_READY_HEAP */
+
+/* The ready lists are sorted by deadline, so a deadline that is after the tick
+ * count wraps belongs in the overflow ready list.  A deadline that was missed
+ * before the tick count wrapped is numerically larger than every other one, so
+ * it is given the value 0 to keep it at the front. */
+    #define taskINSERT_INTO_READY_QUEUE( pxTCB )                                                    \
+    do {                                                                                            \
+        const TickType_t xConstTickCount = xTickCount;                                              \
+        const UBaseType_t uxQueue = taskREADY_QUEUE( pxTCB );                                       \
+                                                                                                    \
+        if( taskTICK_IS_BEFORE( ( pxTCB )->uxDeadline, xConstTickCount ) == pdFALSE )               \
+        {                                                                                           \
+            if( ( pxTCB )->uxDeadline < xConstTickCount )                                           \
+            {                                                                                       \
+                vListInsert( pxOverflowReadyTaskLists[ uxQueue ], &( ( pxTCB )->xStateListItem ) ); \
+            }                                                                                       \
+            else                                                                                    \
+            {                                                                                       \
+                vListInsert( pxReadyTaskLists[ uxQueue ], &( ( pxTCB )->xStateListItem ) );         \
+            }                                                                                       \
+        }                                                                                           \
+        else                                                                                        \
+        {                                                                                           \
+            if( ( pxTCB )->uxDeadline > xConstTickCount )                                           \
+            {                                                                                       \
+                listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), ( TickType_t ) 0U );       \
+            }                                                                                       \
+                                                                                                    \
+            vListInsert( pxReadyTaskLists[ uxQueue ], &( ( pxTCB )->xStateListItem ) );             \
+        }                                                                                           \
+    } while( 0 )
+
+/* The list item is removed from the sorted list along with the task. */
+    #define taskREMOVE_FROM_READY_QUEUE( pxTCB )
+
+    #define taskGET_EARLIEST_DEADLINE_TASK( uxQueue )                                                \
+    ( ( listLIST_IS_EMPTY( pxReadyTaskLists[ ( uxQueue ) ] ) == pdFALSE ) ?                          \
+      ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxReadyTaskLists[ ( uxQueue ) ] ) :                   \
+      ( listLIST_IS_EMPTY( pxOverflowReadyTaskLists[ ( uxQueue ) ] ) == pdFALSE ) ?                  \
+      ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxOverflowReadyTaskLists[ ( uxQueue ) ] ) : NULL )
+
+#endif /* configEDF_USE_READY_HEAP */
+
+/* Evaluates to pdTRUE if the task is in the ready queue it belongs to. */
+#define taskIS_IN_READY_QUEUE( pxTCB )                                                                                            \
+    ( ( ( listIS_CONTAINED_WITHIN( pxReadyTaskLists[ taskREADY_QUEUE( pxTCB ) ], &( ( pxTCB )->xStateListItem ) ) != pdFALSE ) || \
+        ( listIS_CONTAINED_WITHIN( pxOverflowReadyTaskLists[ taskREADY_QUEUE( pxTCB ) ], &( ( pxTCB )->xStateListItem ) ) != pdFALSE ) ) ? pdTRUE : pdFALSE )
+
+/*-----------------------------------------------------------*/
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  It is inserted in order of its absolute deadline.
  */
-//TODO: Overflow?
 #define prvAddTaskToReadyList( pxTCB )                                                                     \
     do {                                                                                                   \
         traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
         listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), pxTCB->uxDeadline );                      \
-        if( pxTCB->uxDeadline == (TickType_t)-1 )                                                          \
+        if( taskIS_BACKGROUND_TASK( pxTCB ) != pdFALSE )                                                   \
             vListInsert( &xIdleTaskList, &( ( pxTCB )->xStateListItem ) );                                 \
         else                                                                                               \
-            vListInsert( pxReadyTaskList, &( ( pxTCB )->xStateListItem ) );                                \
+            taskINSERT_INTO_READY_QUEUE( pxTCB );                                                          \
         tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
     } while( 0 )
 /*-----------------------------------------------------------*/
@@ -369,7 +602,23 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
 
     ListItem_t xStateListItem;                  /**< The list that the state list item of a task is reference from denotes the state of that task (Ready, Blocked, Suspended ). */
     ListItem_t xEventListItem;                  /**< Used to reference a task from an event list. */
-    TickType_t uxDeadline;                      /**< The dealine of the task in ticks */
+    TickType_t uxDeadline;                      /**< The absolute deadline of the current job of the task in ticks. */
+    TickType_t xRelativeDeadline;               /**< The deadline of each job of the task relative to its release, portMAX_DELAY for a task without a deadline. */
+    TickType_t xReleaseTime;                    /**< The tick the current job of the task was released at. */
+    TickType_t xPeriod;                         /**< The time between releases of a periodic task in ticks, 0 if the task is not periodic. */
+    TickType_t xWorstCaseExecutionTime;         /**< The worst case execution time of each job of a periodic task in ticks. */
+    UBaseType_t uxDeadlineMisses;               /**< The number of jobs of the task that have missed their deadline. */
+    BaseType_t xDeadlineMissed;                 /**< pdTRUE once the current job has been counted as missing its deadline. */
+    #if ( configEDF_USE_READY_HEAP == 1 )
+        UBaseType_t uxReadyHeapIndex;           /**< One more than the position of the task in its ready heap, 0 when the task is not in a heap. */
+    #endif
+    #if ( configEDF_PARTITIONED == 1 )
+        BaseType_t xPartitionCoreID;            /**< The core the task is assigned to, it is only ever run there. */
+    #endif
+    #if ( configEDF_USE_SERVERS == 1 )
+        struct tskTaskServer * pxServer;                /**< The server the task runs within, NULL if it is not attached to one. */
+        struct tskTaskControlBlock * pxNextServerTask;  /**< The next task attached to the same server. */
+    #endif
     UBaseType_t uxPriority;                     /**< The priority of the task.  0 is the lowest priority. */ //TODO: Remove
     StackType_t * pxStack;                      /**< Points to the start of the stack. */
     #if ( configNUMBER_OF_CORES > 1 )
@@ -440,6 +689,27 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
  * below to enable the use of older kernel aware debuggers. */
 typedef tskTCB TCB_t;
 
+#if ( configEDF_USE_SERVERS == 1 )
+
+/*
+ * A constant bandwidth server.  The tasks attached to it are scheduled with
+ * xDeadline, and between them run for no more than xBudget ticks in every
+ * xPeriod.
+ */
+    typedef struct tskTaskServer
+    {
+        TickType_t xBudget;          /**< The execution time the server is given every period in ticks. */
+        TickType_t xPeriod;          /**< The period of the server in ticks. */
+        TickType_t xRemainingBudget; /**< The execution time left before the deadline is postponed. */
+        TickType_t xDeadline;        /**< The deadline of the server, given to the tasks attached to it. */
+        TCB_t * pxFirstTask;         /**< The tasks attached to the server, linked through pxNextServerTask. */
+        #if ( configEDF_PARTITIONED == 1 )
+            BaseType_t xPartitionCoreID; /**< The core the server is assigned to, its tasks are only ever run there. */
+        #endif
+    } TaskServer_t;
+
+#endif /* #if ( configEDF_USE_SERVERS == 1 ) */
+
 #if ( configNUMBER_OF_CORES == 1 )
     /* MISRA Ref 8.4.1 [Declaration shall be visible] */
     /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-84 */
@@ -459,10 +729,21 @@ typedef tskTCB TCB_t;
  * the static qualifier. */
 //PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /**< Prioritised ready tasks. */
 PRIVILEGED_DATA static List_t xIdleTaskList;
-PRIVILEGED_DATA static List_t xReadyTaskList1;
-PRIVILEGED_DATA static List_t xReadyTaskList2;
-PRIVILEGED_DATA static List_t * volatile pxReadyTaskList;
-PRIVILEGED_DATA static List_t * volatile pxOverflowReadyTaskList;
+PRIVILEGED_DATA static List_t xReadyTaskLists1[ taskREADY_QUEUE_COUNT ];
+PRIVILEGED_DATA static List_t xReadyTaskLists2[ taskREADY_QUEUE_COUNT ];
+PRIVILEGED_DATA static List_t * volatile pxReadyTaskLists[ taskREADY_QUEUE_COUNT ];
+PRIVILEGED_DATA static List_t * volatile pxOverflowReadyTaskLists[ taskREADY_QUEUE_COUNT ];
+#if ( configEDF_USE_READY_HEAP == 1 )
+    PRIVILEGED_DATA static TCB_t * pxReadyHeaps[ taskREADY_QUEUE_COUNT ][ configEDF_READY_HEAP_LENGTH ]; /**< Ready tasks ordered by deadline, the earliest deadline is at index 0. */
+    PRIVILEGED_DATA static UBaseType_t uxReadyHeapLengths[ taskREADY_QUEUE_COUNT ] = { ( UBaseType_t ) 0U };
+#endif
+PRIVILEGED_DATA static uint32_t ulAdmittedDensity[ taskREADY_QUEUE_COUNT ] = { 0U }; /**< Sum of the densities of the tasks in each ready queue, see prvTaskDensity(). */
+#if ( configEDF_PARTITIONED == 1 )
+    PRIVILEGED_DATA static UBaseType_t uxPartitionTaskCount[ configNUMBER_OF_CORES ]; /**< Number of tasks with a deadline assigned to each core. */
+#endif
+#if ( configUSE_MUTEXES == 1 )
+    PRIVILEGED_DATA static volatile TickType_t xSystemCeiling = portMAX_DELAY; /**< The lowest ceiling of the mutexes that are held, portMAX_DELAY when none are. */
+#endif
 PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /**< Delayed tasks. */
 PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /**< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /**< Points to the delayed task list currently being used. */
@@ -560,6 +841,21 @@ static BaseType_t prvCreateIdleTasks( void );
  * Selects the highest priority available task for the given core.
  */
     static void prvSelectHighestPriorityTask( BaseType_t xCoreID );
+
+/*
+ * Returns pdTRUE if pxTCB can be selected to run on the given core, which is
+ * when it is already running there or is not running anywhere and its
+ * affinity allows the core.
+ */
+    static BaseType_t prvTaskCanRunOnCore( const TCB_t * pxTCB,
+                                           BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the first task in the deadline ordered list pxList that can run on
+ * the given core, or NULL if there is none.
+ */
+    static TCB_t * prvSelectTaskFromListForCore( List_t * pxList,
+                                                 BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
 #endif /* #if ( configNUMBER_OF_CORES > 1 ) */
 
 /**
@@ -607,7 +903,7 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
  * This does not free memory allocated by the task itself (i.e. memory
  * allocated by calls to pvPortMalloc from within the tasks application code).
  */
-#if ( INCLUDE_vTaskDelete == 1 )
+#if ( ( INCLUDE_vTaskDelete == 1 ) || ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configADMISSION_CONTROL == ADMISSION_CONTROL_REJECT ) ) )
 
     static void prvDeleteTCB( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
 
@@ -698,6 +994,133 @@ static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
 #endif
 
+#if ( configEDF_USE_READY_HEAP == 1 )
+
+/*
+ * Add a task to, or remove a task from, the deadline ordered ready heap.
+ */
+    static void prvReadyHeapInsert( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    static void prvReadyHeapRemove( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+    #if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * Returns the earliest deadline ready task that xCoreID is allowed to run, or
+ * NULL if there is none.
+ */
+        static TCB_t * prvReadyHeapSelectForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+    #endif
+#endif /* #if ( configEDF_USE_READY_HEAP == 1 ) */
+
+#if ( configUSE_MUTEXES == 1 )
+
+/*
+ * Returns the task to run while the system ceiling is keeping pxEarliestTCB,
+ * the earliest deadline ready task, from starting.  That is the earliest
+ * deadline ready task that passes the ceiling, or failing that a task without
+ * a deadline that holds a mutex, or NULL if there is neither.
+ */
+    static TCB_t * prvSelectTaskUnderCeiling( TCB_t * pxEarliestTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Returns the share of a core the task needs, where taskUTILIZATION_ONE is the
+ * whole core.  A task with no worst case execution time counts as 0.
+ */
+static uint32_t prvTaskDensity( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Admission control.  prvAdmitTask() adds the density of the task to the
+ * ready queue it will use, after assigning it a core with partitioned EDF.  If
+ * that goes over the EDF bound it calls traceTASK_ADMISSION_FAILED(), and with
+ * ADMISSION_CONTROL_REJECT returns pdFAIL without admitting the task, when
+ * xMayReject allows.  prvReleaseTask() takes the density off again.  The task
+ * must not be in a ready queue while either is called.
+ */
+static BaseType_t prvAdmitTask( TCB_t * pxTCB,
+                                BaseType_t xMayReject ) PRIVILEGED_FUNCTION;
+static void prvReleaseTask( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if ulDensity more can be admitted to the ready queue uxQueue
+ * without going over the EDF bound.
+ */
+static BaseType_t prvDensityFits( UBaseType_t uxQueue,
+                                  uint32_t ulDensity ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from the tick interrupt when the job at the head of a ready queue has
+ * passed its deadline.  Counts the miss and applies
+ * configEDF_DEADLINE_MISS_POLICY.  Returns pdTRUE if the core the tick
+ * interrupt is running on has to switch context.
+ */
+static BaseType_t prvDeadlineMissed( TCB_t * pxTCB,
+                                     TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the task waiting on pxEventList that would have the earliest
+ * deadline if it were released at the current tick, or the one that has
+ * waited longest of those with the same deadline.  A task without a deadline
+ * is only returned if no task with one is waiting.  pxEventList must not be
+ * empty.
+ */
+static TCB_t * prvGetEarliestDeadlineWaiter( const List_t * pxEventList ) PRIVILEGED_FUNCTION;
+
+#if ( configEDF_USE_SERVERS == 1 )
+
+/*
+ * Admits a new server like a periodic task with the same budget and period,
+ * and sets it up with no budget left so the first task released to it starts
+ * a new server period.
+ */
+    static BaseType_t prvInitialiseNewServer( TickType_t xBudget,
+                                              TickType_t xPeriod,
+                                              TaskServer_t * pxNewServer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called in place of taskSTART_JOB() when a task attached to a server is
+ * released.  If none of the other tasks of the server are ready the server has
+ * been idle, and is given a new deadline and a full budget unless the budget it
+ * has left can be used up by its current deadline without going over its
+ * bandwidth.  The task then takes the deadline of the server.
+ */
+    static void prvServerReleaseJob( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from the tick interrupt for each core running a task attached to
+ * the server.  Takes the tick from the budget, and once the budget runs out
+ * refills it and postpones the deadline of the server and its ready tasks by a
+ * period.  Returns pdTRUE if the core the tick interrupt is running on has to
+ * switch context.
+ */
+    static BaseType_t prvServerChargeTick( TaskServer_t * pxServer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes a task that is being deleted off the list of tasks of its server.
+ */
+    static void prvServerRemoveTask( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif /* #if ( configEDF_USE_SERVERS == 1 ) */
+
+#if ( configEDF_PARTITIONED == 1 )
+
+/*
+ * Returns the core a task or server of density ulDensity is to be assigned to,
+ * one of the cores uxCoreAffinityMask allows, using
+ * configEDF_PARTITION_HEURISTIC.
+ */
+    static BaseType_t prvPartitionSelectCore( UBaseType_t uxCoreAffinityMask,
+                                              uint32_t ulDensity ) PRIVILEGED_FUNCTION;
+
+/*
+ * Reassigns the ready tasks in order of decreasing density, which packs
+ * them better than the order they happened to be created in.  Called once,
+ * just before the scheduler starts.
+ */
+    static void prvPartitionReadyTasks( void ) PRIVILEGED_FUNCTION;
+#endif /* #if ( configEDF_PARTITIONED == 1 ) */
+
 /*
  * Called after a Task_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -715,7 +1138,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
  * Called after a new task has been created and initialised to place the task
  * under the control of the scheduler.
  */
-static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
+static BaseType_t prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
 /*
  * Create a task with static buffer for both TCB and stack. Returns a handle to
@@ -878,88 +1301,58 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 #if ( configNUMBER_OF_CORES > 1 )
     static void prvYieldForTask( const TCB_t * pxTCB )
     {
-        BaseType_t xLowestPriorityToPreempt;
-        BaseType_t xCurrentCoreTaskPriority;
-        BaseType_t xLowestPriorityCore = ( BaseType_t ) -1;
+        const TCB_t * pxLatestTCB = NULL;
+        BaseType_t xLatestDeadlineCore = ( BaseType_t ) -1;
         BaseType_t xCoreID;
+        BaseType_t xFirstCoreID = ( BaseType_t ) 0;
+        BaseType_t xLastCoreID = ( BaseType_t ) ( configNUMBER_OF_CORES - 1 );
         const BaseType_t xCurrentCoreID = portGET_CORE_ID();
 
-        #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
-            BaseType_t xYieldCount = 0;
-        #endif /* #if ( configRUN_MULTIPLE_PRIORITIES == 0 ) */
-
         /* This must be called from a critical section. */
         configASSERT( portGET_CRITICAL_NESTING_COUNT( xCurrentCoreID ) > 0U );
 
-        #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
-
-            /* No task should yield for this one if it is a lower priority
-             * than priority level of currently ready tasks. */
-            if( pxTCB->uxPriority >= uxTopReadyPriority )
-        #else
-            /* Yield is not required for a task which is already running. */
-            if( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE )
-        #endif
+        /* Yield is not required for a task which is already running. */
+        if( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE )
         {
-            xLowestPriorityToPreempt = ( BaseType_t ) pxTCB->uxPriority;
-
-            /* xLowestPriorityToPreempt will be decremented to -1 if the priority of pxTCB
-             * is 0. This is ok as we will give system idle tasks a priority of -1 below. */
-            --xLowestPriorityToPreempt;
-
-            for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            /* Global EDF runs the configNUMBER_OF_CORES earliest deadline tasks,
+             * so the task can only take the core that is running the latest
+             * deadline task.  Idle tasks have no deadline so are always the
+             * latest. */
+            #if ( configEDF_PARTITIONED == 1 )
             {
-                xCurrentCoreTaskPriority = ( BaseType_t ) pxCurrentTCBs[ xCoreID ]->uxPriority;
-
-                /* System idle tasks are being assigned a priority of tskIDLE_PRIORITY - 1 here. */
-                if( ( pxCurrentTCBs[ xCoreID ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+                /* A partitioned task only competes with the tasks of its own
+                 * core.  Background tasks are not partitioned. */
+                if( taskIS_BACKGROUND_TASK( pxTCB ) == pdFALSE )
                 {
-                    xCurrentCoreTaskPriority = ( BaseType_t ) ( xCurrentCoreTaskPriority - 1 );
+                    xFirstCoreID = pxTCB->xPartitionCoreID;
+                    xLastCoreID = pxTCB->xPartitionCoreID;
                 }
+            }
+            #endif /* #if ( configEDF_PARTITIONED == 1 ) */
 
+            for( xCoreID = xFirstCoreID; xCoreID <= xLastCoreID; xCoreID++ )
+            {
                 if( ( taskTASK_IS_RUNNING( pxCurrentTCBs[ xCoreID ] ) != pdFALSE ) && ( xYieldPendings[ xCoreID ] == pdFALSE ) )
                 {
-                    #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
-                        if( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE )
+                    #if ( configUSE_CORE_AFFINITY == 1 )
+                        if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
                     #endif
                     {
-                        if( xCurrentCoreTaskPriority <= xLowestPriorityToPreempt )
+                        #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
+                            if( pxCurrentTCBs[ xCoreID ]->xPreemptionDisable == pdFALSE )
+                        #endif
                         {
-                            #if ( configUSE_CORE_AFFINITY == 1 )
-                                if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
-                            #endif
+                            if( ( pxLatestTCB == NULL ) || ( taskDEADLINE_IS_EARLIER( pxLatestTCB, pxCurrentTCBs[ xCoreID ] ) != pdFALSE ) )
                             {
-                                #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
-                                    if( pxCurrentTCBs[ xCoreID ]->xPreemptionDisable == pdFALSE )
-                                #endif
-                                {
-                                    xLowestPriorityToPreempt = xCurrentCoreTaskPriority;
-                                    xLowestPriorityCore = xCoreID;
-                                }
+                                pxLatestTCB = pxCurrentTCBs[ xCoreID ];
+                                xLatestDeadlineCore = xCoreID;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
                             }
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-
-                    #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
-                    {
-                        /* Yield all currently running non-idle tasks with a priority lower than
-                         * the task that needs to run. */
-                        if( ( xCurrentCoreTaskPriority > ( ( BaseType_t ) tskIDLE_PRIORITY - 1 ) ) &&
-                            ( xCurrentCoreTaskPriority < ( BaseType_t ) pxTCB->uxPriority ) )
-                        {
-                            prvYieldCore( xCoreID );
-                            xYieldCount++;
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
                         }
                     }
-                    #endif /* #if ( configRUN_MULTIPLE_PRIORITIES == 0 ) */
                 }
                 else
                 {
@@ -967,193 +1360,829 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 }
             }
 
-            #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
-                if( ( xYieldCount == 0 ) && ( xLowestPriorityCore >= 0 ) )
-            #else /* #if ( configRUN_MULTIPLE_PRIORITIES == 0 ) */
-                if( xLowestPriorityCore >= 0 )
-            #endif /* #if ( configRUN_MULTIPLE_PRIORITIES == 0 ) */
+            if( ( pxLatestTCB != NULL ) && ( taskDEADLINE_IS_EARLIER( pxTCB, pxLatestTCB ) != pdFALSE ) )
             {
-                prvYieldCore( xLowestPriorityCore );
+                prvYieldCore( xLatestDeadlineCore );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
-
-            #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
-                /* Verify that the calling core always yields to higher priority tasks. */
-                if( ( ( pxCurrentTCBs[ xCurrentCoreID ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) == 0U ) &&
-                    ( pxTCB->uxPriority > pxCurrentTCBs[ xCurrentCoreID ]->uxPriority ) )
-                {
-                    configASSERT( ( xYieldPendings[ xCurrentCoreID ] == pdTRUE ) ||
-                                  ( taskTASK_IS_RUNNING( pxCurrentTCBs[ xCurrentCoreID ] ) == pdFALSE ) );
-                }
-            #endif
         }
     }
 #endif /* #if ( configNUMBER_OF_CORES > 1 ) */
 /*-----------------------------------------------------------*/
 
 #if ( configNUMBER_OF_CORES > 1 )
+    static BaseType_t prvTaskCanRunOnCore( const TCB_t * pxTCB,
+                                           BaseType_t xCoreID )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( pxTCB == pxCurrentTCBs[ xCoreID ] )
+        {
+            xReturn = pdTRUE;
+        }
+        else if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+        {
+            #if ( configUSE_CORE_AFFINITY == 1 )
+                if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
+            #endif
+            {
+                xReturn = pdTRUE;
+            }
+        }
+        else
+        {
+            /* Running on another core. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static TCB_t * prvSelectTaskFromListForCore( List_t * pxList,
+                                                 BaseType_t xCoreID )
+    {
+        const ListItem_t * pxEndMarker = listGET_END_MARKER( pxList );
+        ListItem_t * pxIterator;
+        TCB_t * pxTCB;
+        TCB_t * pxSelectedTCB = NULL;
+
+        /* The list is in deadline order so the first task that can run is the
+         * one to use. */
+        for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxTCB = listGET_LIST_ITEM_OWNER( pxIterator );
+
+            if( prvTaskCanRunOnCore( pxTCB, xCoreID ) != pdFALSE )
+            {
+                pxSelectedTCB = pxTCB;
+                break;
+            }
+        }
+
+        return pxSelectedTCB;
+    }
+/*-----------------------------------------------------------*/
+
     static void prvSelectHighestPriorityTask( BaseType_t xCoreID )
     {
-        BaseType_t xTaskScheduled = pdFALSE;
-        BaseType_t xDecrementTopPriority = pdTRUE;
-        TCB_t * pxTCB = NULL;
+        TCB_t * pxTCB;
 
         #if ( configUSE_CORE_AFFINITY == 1 )
             const TCB_t * pxPreviousTCB = NULL;
         #endif
-        #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
-            BaseType_t xPriorityDropped = pdFALSE;
-        #endif
 
         /* This function should be called when scheduler is running. */
         configASSERT( xSchedulerRunning == pdTRUE );
 
-        /* A new task is created and a running task with the same priority yields
-         * itself to run the new task. When a running task yields itself, it is still
-         * in the ready list. This running task will be selected before the new task
-         * since the new task is always added to the end of the ready list.
-         * The other problem is that the running task still in the same position of
-         * the ready list when it yields itself. It is possible that it will be selected
-         * earlier then other tasks which waits longer than this task.
-         *
-         * To fix these problems, the running task should be put to the end of the
-         * ready list before searching for the ready task in the ready list. */
-        if( listIS_CONTAINED_WITHIN( pxReadyTaskList,
-                                     &pxCurrentTCBs[ xCoreID ]->xStateListItem ) == pdTRUE )
+        /* Pick the earliest deadline task that is not already running on
+         * another core.  With partitioned EDF only the ready queue of this core
+         * is looked at, and the task found first is nearly always its head. */
+        #if ( configEDF_USE_READY_HEAP == 1 )
         {
-            ( void ) uxListRemove( &pxCurrentTCBs[ xCoreID ]->xStateListItem );
-            vListInsertEnd( pxReadyTaskList,
-                            &pxCurrentTCBs[ xCoreID ]->xStateListItem );
+            pxTCB = prvReadyHeapSelectForCore( xCoreID );
         }
-
-        if( listLIST_IS_EMPTY( pxReadyTaskList ) == pdFALSE )
+        #else
         {
-            const ListItem_t * pxEndMarker = listGET_END_MARKER( pxReadyTaskList );
-            ListItem_t * pxIterator;
+            #if ( configEDF_PARTITIONED == 1 )
+                const UBaseType_t uxQueue = ( UBaseType_t ) xCoreID;
+            #else
+                const UBaseType_t uxQueue = 0U;
+            #endif
 
-            // There are some tasks ready to run
-            // Iterate through them
+            /* Tasks in the overflow ready list have deadlines after the tick
+             * count wraps, so they are only looked at after the ready list. */
+            pxTCB = prvSelectTaskFromListForCore( pxReadyTaskLists[ uxQueue ], xCoreID );
 
-            for( pxIterator = listGET_HEAD_ENTRY( pxReadyTaskList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+            if( pxTCB == NULL )
             {
-                pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
-
-                if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
-                {
-                    // The task is not currently on another core
-                    if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) )
-                    {
-                        pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING; // Mark the current TCB as not running
-                        pxPreviousTCB = pxCurrentTCBs[ xCoreID ]; // We're ejecting the currently running task, note what it was
-                        pxTCB->xTaskRunState = xCoreID;
-                        pxCurrentTCBs[ xCoreID ] = pxTCB;
-                        xTaskScheduled = pdTRUE;
-                    }
-                }
-                else if ( pxTCB == pxCurrentTCBs[ xCoreID ] )
-                {
-                    // Task was already running on this core
-                    pxTCB->xTaskRunState = xCoreID;
-                    xTaskScheduled = pdTRUE;
-                }
-
-                if( xTaskScheduled )
-                {
-                    // We found a task, stop iterating
-                    break;
-                }
+                pxTCB = prvSelectTaskFromListForCore( pxOverflowReadyTaskLists[ uxQueue ], xCoreID );
             }
         }
+        #endif /* configEDF_USE_READY_HEAP */
 
-        if( xTaskScheduled == pdFALSE )
+        if( pxTCB == NULL )
         {
-            // Schedule in the idle task
-            pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xIdleTaskList );
-            
-            if ( pxTCB == pxCurrentTCBs[ xCoreID] )
-            {
-                // Idle was already running
-                pxCurrentTCB->xTaskRunState = xCoreID;
-                xTaskScheduled = pdTRUE;
-            }
-            else
-            {
-                // Schedule it in
-                pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING; // Mark the current TCB as not running
-                pxTCB->xTaskRunState = xCoreID;
-                pxCurrentTCBs[ xCoreID ] = pxTCB;
-                xTaskScheduled = pdTRUE;
-            }
+            // Nothing with a deadline can run here, schedule in an idle task
+            pxTCB = prvSelectTaskFromListForCore( &xIdleTaskList, xCoreID );
         }
 
-        #if ( configRUN_MULTIPLE_PRIORITIES == 0 )
+        /* There is an idle task for every core. */
+        configASSERT( pxTCB != NULL );
+
+        if( pxTCB != pxCurrentTCBs[ xCoreID ] )
         {
-            if( xTaskScheduled == pdTRUE )
-            {
-                if( xPriorityDropped != pdFALSE )
-                {
-                    /* There may be several ready tasks that were being prevented from running because there was
-                     * a higher priority task running. Now that the last of the higher priority tasks is no longer
-                     * running, make sure all the other idle tasks yield. */
-                    BaseType_t x;
+            pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING; // Mark the current TCB as not running
 
-                    for( x = ( BaseType_t ) 0; x < ( BaseType_t ) configNUMBER_OF_CORES; x++ )
-                    {
-                        if( ( pxCurrentTCBs[ x ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
-                        {
-                            prvYieldCore( x );
-                        }
-                    }
-                }
-            }
+            #if ( configUSE_CORE_AFFINITY == 1 )
+                pxPreviousTCB = pxCurrentTCBs[ xCoreID ]; // We're ejecting the currently running task, note what it was
+            #endif
+
+            pxCurrentTCBs[ xCoreID ] = pxTCB;
         }
-        #endif /* #if ( configRUN_MULTIPLE_PRIORITIES == 0 ) */
 
-        #if ( configUSE_CORE_AFFINITY == 1 )
+        pxTCB->xTaskRunState = xCoreID;
+
+        #if ( configEDF_PARTITIONED == 1 )
         {
-            if( xTaskScheduled == pdTRUE )
+            /* A partitioned task can only run on its own core, so there is no
+             * other core to move it to.  The exception is a task that
+             * vTaskCoreAffinitySet() assigned to another core while it was
+             * running here, which that core can only take now it has left. */
+            if( ( pxPreviousTCB != NULL ) &&
+                ( taskIS_BACKGROUND_TASK( pxPreviousTCB ) == pdFALSE ) &&
+                ( pxPreviousTCB->xPartitionCoreID != xCoreID ) &&
+                ( taskIS_IN_READY_QUEUE( pxPreviousTCB ) != pdFALSE ) &&
+                ( xYieldPendings[ pxPreviousTCB->xPartitionCoreID ] == pdFALSE ) &&
+                ( taskDEADLINE_IS_EARLIER( pxPreviousTCB, pxCurrentTCBs[ pxPreviousTCB->xPartitionCoreID ] ) != pdFALSE ) )
             {
-                if( ( pxPreviousTCB != NULL ) && ( listIS_CONTAINED_WITHIN( pxReadyTaskList, &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
-                {
-                    /* A ready task was just evicted from this core. See if it can be
-                     * scheduled on any other core. */
-                    UBaseType_t uxCoreMap = pxPreviousTCB->uxCoreAffinityMask;
-                    BaseType_t xHighestDeadline = ( BaseType_t ) pxPreviousTCB->uxDeadline;
-                    BaseType_t xHighestDeadlineCore = -1;
-                    BaseType_t x;
+                prvYieldCore( pxPreviousTCB->xPartitionCoreID );
+            }
+        }
+        #elif ( configUSE_CORE_AFFINITY == 1 )
+        {
+            if( ( pxPreviousTCB != NULL ) && ( taskIS_IN_READY_QUEUE( pxPreviousTCB ) != pdFALSE ) )
+            {
+                /* A ready task was just evicted from this core. See if it can be
+                 * scheduled on any other core, which is the case if another core
+                 * it is allowed on is running a task with a later deadline. */
+                const TCB_t * pxLatestTCB = pxPreviousTCB;
+                BaseType_t xLatestDeadlineCore = ( BaseType_t ) -1;
+                BaseType_t x;
 
-                    for( x = ( ( BaseType_t ) configNUMBER_OF_CORES - 1 ); x >= ( BaseType_t ) 0; x-- )
+                for( x = ( ( BaseType_t ) configNUMBER_OF_CORES - 1 ); x >= ( BaseType_t ) 0; x-- )
+                {
+                    if( ( x != xCoreID ) &&
+                        ( ( pxPreviousTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) x ) ) != 0U ) &&
+                        ( taskTASK_IS_RUNNING( pxCurrentTCBs[ x ] ) != pdFALSE ) &&
+                        ( xYieldPendings[ x ] == pdFALSE ) &&
+                        ( taskDEADLINE_IS_EARLIER( pxLatestTCB, pxCurrentTCBs[ x ] ) != pdFALSE ) )
                     {
-                        UBaseType_t uxCore = ( UBaseType_t ) x;
-                        TickType_t xTaskDeadline;
-
-                        if( uxCoreMap & ( ( UBaseType_t ) 1U << uxCore ) == 0 )
-                            continue; // The task is not allowed to run on this core
-
-                        if( xTaskDeadline > xHighestDeadline &&
-                            ( taskTASK_IS_RUNNING( pxCurrentTCBs[ uxCore ] ) != pdFALSE ) &&
-                            ( xYieldPendings[ uxCore ] == pdFALSE ) )
-                        {
-                            xHighestDeadline = xTaskDeadline;
-                            xHighestDeadlineCore = ( BaseType_t )uxCore;
-                        }
+                        pxLatestTCB = pxCurrentTCBs[ x ];
+                        xLatestDeadlineCore = x;
                     }
+                }
 
-                    if( xHighestDeadlineCore >= 0 )
-                    {
-                        // It should be running on this core since it currently has a higher deadline
-                        prvYieldCore( xHighestDeadlineCore );
-                    }
+                if( xLatestDeadlineCore >= 0 )
+                {
+                    prvYieldCore( xLatestDeadlineCore );
                 }
             }
         }
-        #endif /* #if ( configUSE_CORE_AFFINITY == 1 ) */
+        #endif /* #if ( configEDF_PARTITIONED == 1 ) */
     }
 
 #endif /* ( configNUMBER_OF_CORES > 1 ) */
 
 /*-----------------------------------------------------------*/
 
-#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+static uint32_t prvTaskDensity( const TCB_t * pxTCB )
+{
+    /* Constrained deadlines are allowed, so the density C / min( D, T ) is
+     * used.  It is the utilization of a task whose deadline is its period. */
+    TickType_t xInterval = pxTCB->xRelativeDeadline;
+    uint64_t ullDensity = 0U;
+
+    if( ( pxTCB->xPeriod != ( TickType_t ) 0U ) && ( pxTCB->xPeriod < xInterval ) )
+    {
+        xInterval = pxTCB->xPeriod;
+    }
+
+    if( ( taskIS_BACKGROUND_TASK( pxTCB ) == pdFALSE ) && ( xInterval != ( TickType_t ) 0U ) )
+    {
+        ullDensity = ( ( uint64_t ) pxTCB->xWorstCaseExecutionTime * taskUTILIZATION_ONE ) / xInterval;
+    }
+
+    #if ( configEDF_USE_SERVERS == 1 )
+    {
+        /* The server has already been admitted for the time the task uses. */
+        if( pxTCB->pxServer != NULL )
+        {
+            ullDensity = 0U;
+        }
+    }
+    #endif
+
+    /* Stop the sums overflowing, a task this large is never admissible. */
+    if( ullDensity > taskDENSITY_MAX )
+    {
+        ullDensity = taskDENSITY_MAX;
+    }
+
+    return ( uint32_t ) ullDensity;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configEDF_PARTITIONED == 1 )
+
+    static BaseType_t prvPartitionSelectCore( UBaseType_t uxCoreAffinityMask,
+                                              uint32_t ulDensity )
+    {
+        BaseType_t xCoreID;
+        BaseType_t xSelectedCoreID = ( BaseType_t ) -1;
+        BaseType_t xLeastLoadedCoreID = ( BaseType_t ) -1;
+
+        for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            if( ( uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
+            {
+                /* Tasks with no execution time to pack are spread out by
+                 * number instead. */
+                if( ( xLeastLoadedCoreID < ( BaseType_t ) 0 ) ||
+                    ( ulAdmittedDensity[ xCoreID ] < ulAdmittedDensity[ xLeastLoadedCoreID ] ) ||
+                    ( ( ulAdmittedDensity[ xCoreID ] == ulAdmittedDensity[ xLeastLoadedCoreID ] ) &&
+                      ( uxPartitionTaskCount[ xCoreID ] < uxPartitionTaskCount[ xLeastLoadedCoreID ] ) ) )
+                {
+                    xLeastLoadedCoreID = xCoreID;
+                }
+
+                #if ( configEDF_PARTITION_HEURISTIC == EDF_PARTITION_FIRST_FIT )
+                {
+                    if( ( xSelectedCoreID < ( BaseType_t ) 0 ) && ( ulDensity > 0U ) &&
+                        ( prvDensityFits( ( UBaseType_t ) xCoreID, ulDensity ) != pdFALSE ) )
+                    {
+                        xSelectedCoreID = xCoreID;
+                    }
+                }
+                #endif
+            }
+        }
+
+        /* Worst fit always takes the least loaded core.  First fit falls back
+         * to it when the task does not fit on any core. */
+        if( xSelectedCoreID < ( BaseType_t ) 0 )
+        {
+            xSelectedCoreID = xLeastLoadedCoreID;
+        }
+
+        /* The affinity mask must allow at least one core. */
+        configASSERT( xSelectedCoreID >= ( BaseType_t ) 0 );
+
+        return xSelectedCoreID;
+    }
+
+#endif /* #if ( configEDF_PARTITIONED == 1 ) */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvAdmitTask( TCB_t * pxTCB,
+                                BaseType_t xMayReject )
+{
+    const uint32_t ulDensity = prvTaskDensity( pxTCB );
+    UBaseType_t uxQueue;
+    BaseType_t xReturn = pdPASS;
+
+    /* Background tasks only use time no other task wants. */
+    if( taskIS_BACKGROUND_TASK( pxTCB ) == pdFALSE )
+    {
+        #if ( configEDF_PARTITIONED == 1 )
+        {
+            #if ( configEDF_USE_SERVERS == 1 )
+                if( pxTCB->pxServer != NULL )
+                {
+                    /* The task runs with the deadline of its server, so is
+                     * scheduled on the same core. */
+                    pxTCB->xPartitionCoreID = pxTCB->pxServer->xPartitionCoreID;
+                }
+                else
+            #endif
+            {
+                pxTCB->xPartitionCoreID = prvPartitionSelectCore( pxTCB->uxCoreAffinityMask, ulDensity );
+            }
+        }
+        #endif /* if ( configEDF_PARTITIONED == 1 ) */
+
+        uxQueue = taskREADY_QUEUE( pxTCB );
+
+        if( prvDensityFits( uxQueue, ulDensity ) == pdFALSE )
+        {
+            traceTASK_ADMISSION_FAILED( pxTCB );
+
+            #if ( configADMISSION_CONTROL == ADMISSION_CONTROL_REJECT )
+            {
+                if( xMayReject != pdFALSE )
+                {
+                    xReturn = pdFAIL;
+                }
+            }
+            #else
+            {
+                ( void ) xMayReject;
+            }
+            #endif
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xReturn != pdFAIL )
+        {
+            ulAdmittedDensity[ uxQueue ] += ulDensity;
+
+            #if ( configEDF_PARTITIONED == 1 )
+            {
+                uxPartitionTaskCount[ uxQueue ]++;
+            }
+            #endif
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvDensityFits( UBaseType_t uxQueue,
+                                  uint32_t ulDensity )
+{
+    BaseType_t xReturn = pdTRUE;
+
+    /* A task with no execution time is always admitted. */
+    if( ( ulDensity > taskUTILIZATION_ONE ) ||
+        ( ( ulDensity > 0U ) && ( ( ulAdmittedDensity[ uxQueue ] + ulDensity ) > taskADMISSION_BOUND ) ) )
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReleaseTask( const TCB_t * pxTCB )
+{
+    if( taskIS_BACKGROUND_TASK( pxTCB ) == pdFALSE )
+    {
+        ulAdmittedDensity[ taskREADY_QUEUE( pxTCB ) ] -= prvTaskDensity( pxTCB );
+
+        #if ( configEDF_PARTITIONED == 1 )
+        {
+            uxPartitionTaskCount[ taskREADY_QUEUE( pxTCB ) ]--;
+        }
+        #endif
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvDeadlineMissed( TCB_t * pxTCB,
+                                     TickType_t xConstTickCount )
+{
+    BaseType_t xSwitchRequired = pdFALSE;
+
+    #if ( configEDF_DEADLINE_MISS_POLICY == EDF_DEADLINE_MISS_ABORT )
+        TickType_t xNextRelease;
+    #endif
+
+    traceTASK_DEADLINE_MISSED( pxTCB );
+
+    pxTCB->uxDeadlineMisses++;
+    pxTCB->xDeadlineMissed = pdTRUE;
+
+    #if ( configEDF_DEADLINE_MISS_POLICY == EDF_DEADLINE_MISS_HOOK )
+    {
+        /* The task carries on, the hook decides what to do about it. */
+        vApplicationDeadlineMissedHook( pxTCB );
+    }
+    #elif ( ( configEDF_DEADLINE_MISS_POLICY == EDF_DEADLINE_MISS_ABORT ) || ( configEDF_DEADLINE_MISS_POLICY == EDF_DEADLINE_MISS_DEMOTE ) )
+    {
+        taskREMOVE_FROM_READY_QUEUE( pxTCB );
+        listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+
+        #if ( configEDF_DEADLINE_MISS_POLICY == EDF_DEADLINE_MISS_ABORT )
+            if( pxTCB->xPeriod != ( TickType_t ) 0U )
+            {
+                /* Skip to the first release that is still to come, so the
+                 * task stops competing with jobs that can meet their
+                 * deadline. */
+                xNextRelease = pxTCB->xReleaseTime +
+                               ( ( ( ( TickType_t ) ( xConstTickCount - pxTCB->xReleaseTime ) ) / pxTCB->xPeriod ) + ( TickType_t ) 1U ) * pxTCB->xPeriod;
+                taskSTART_JOB( pxTCB, xNextRelease );
+
+                listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), xNextRelease );
+
+                if( xNextRelease < xConstTickCount )
+                {
+                    traceMOVED_TASK_TO_OVERFLOW_DELAYED_LIST();
+                    vListInsert( pxOverflowDelayedTaskList, &( pxTCB->xStateListItem ) );
+                }
+                else
+                {
+                    traceMOVED_TASK_TO_DELAYED_LIST();
+                    vListInsert( pxDelayedTaskList, &( pxTCB->xStateListItem ) );
+
+                    if( xNextRelease < xNextTaskUnblockTime )
+                    {
+                        xNextTaskUnblockTime = xNextRelease;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            else
+        #endif /* if ( configEDF_DEADLINE_MISS_POLICY == EDF_DEADLINE_MISS_ABORT ) */
+        {
+            /* Move the job behind every deadline that can still be met until
+             * the task starts its next job.  A task that is not periodic has no
+             * next release to skip to, so is always demoted. */
+            pxTCB->uxDeadline = xConstTickCount + ( portMAX_DELAY >> 1 );
+            prvAddTaskToReadyList( pxTCB );
+        }
+
+        /* The job no longer has the earliest deadline, so give up the core it
+         * is running on. */
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            if( pxTCB == pxCurrentTCB )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else
+        {
+            if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
+            {
+                if( pxTCB->xTaskRunState == ( BaseType_t ) portGET_CORE_ID() )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    prvYieldCore( pxTCB->xTaskRunState );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+    }
+    #else /* if ( configEDF_DEADLINE_MISS_POLICY == EDF_DEADLINE_MISS_HOOK ) */
+    {
+        /* EDF_DEADLINE_MISS_COUNT, the job carries on at the head of the
+         * queue. */
+        ( void ) xConstTickCount;
+    }
+    #endif /* if ( configEDF_DEADLINE_MISS_POLICY == EDF_DEADLINE_MISS_HOOK ) */
+
+    return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+static TCB_t * prvGetEarliestDeadlineWaiter( const List_t * pxEventList )
+{
+    const TickType_t xConstTickCount = xTickCount;
+    const ListItem_t * const pxEndMarker = listGET_END_MARKER( pxEventList );
+    const ListItem_t * pxIterator;
+    TCB_t * pxTCB;
+    TCB_t * pxEarliestTCB = NULL;
+    TickType_t xDeadline;
+    TickType_t xEarliestDeadline = ( TickType_t ) 0U;
+
+    for( pxIterator = listGET_HEAD_ENTRY( pxEventList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+    {
+        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        pxTCB = listGET_LIST_ITEM_OWNER( pxIterator );
+
+        if( taskIS_BACKGROUND_TASK( pxTCB ) != pdFALSE )
+        {
+            if( pxEarliestTCB == NULL )
+            {
+                pxEarliestTCB = pxTCB;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            continue;
+        }
+
+        /* The deadline taskRELEASE_JOB() would give the task now.  A periodic
+         * task keeps the deadline of its current job, and one that is not
+         * periodic is due its relative deadline from now.  A task attached to
+         * a server keeps the deadline of the server while the server has one
+         * ahead, and otherwise gets a new server period. */
+        #if ( configEDF_USE_SERVERS == 1 )
+            if( pxTCB->pxServer != NULL )
+            {
+                if( taskTICK_IS_BEFORE( xConstTickCount, pxTCB->pxServer->xDeadline ) != pdFALSE )
+                {
+                    xDeadline = pxTCB->pxServer->xDeadline;
+                }
+                else
+                {
+                    xDeadline = xConstTickCount + pxTCB->pxServer->xPeriod;
+                }
+            }
+            else
+        #endif /* configEDF_USE_SERVERS */
+
+        if( pxTCB->xPeriod != ( TickType_t ) 0U )
+        {
+            xDeadline = pxTCB->uxDeadline;
+        }
+        else
+        {
+            xDeadline = xConstTickCount + pxTCB->xRelativeDeadline;
+        }
+
+        if( ( pxEarliestTCB == NULL ) ||
+            ( taskIS_BACKGROUND_TASK( pxEarliestTCB ) != pdFALSE ) ||
+            ( taskTICK_IS_BEFORE( xDeadline, xEarliestDeadline ) != pdFALSE ) )
+        {
+            pxEarliestTCB = pxTCB;
+            xEarliestDeadline = xDeadline;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    return pxEarliestTCB;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configEDF_USE_SERVERS == 1 )
+
+    static BaseType_t prvInitialiseNewServer( TickType_t xBudget,
+                                              TickType_t xPeriod,
+                                              TaskServer_t * pxNewServer )
+    {
+        const uint32_t ulDensity = ( uint32_t ) ( ( ( uint64_t ) xBudget * taskUTILIZATION_ONE ) / xPeriod );
+        UBaseType_t uxQueue = ( UBaseType_t ) 0U;
+        BaseType_t xReturn = pdPASS;
+
+        pxNewServer->xBudget = xBudget;
+        pxNewServer->xPeriod = xPeriod;
+        pxNewServer->pxFirstTask = NULL;
+
+        taskENTER_CRITICAL();
+        {
+            /* With no budget left the first task released to the server
+             * always starts a new server period. */
+            pxNewServer->xRemainingBudget = ( TickType_t ) 0U;
+            pxNewServer->xDeadline = xTickCount;
+
+            #if ( configEDF_PARTITIONED == 1 )
+            {
+                pxNewServer->xPartitionCoreID = prvPartitionSelectCore( tskNO_AFFINITY, ulDensity );
+                uxQueue = ( UBaseType_t ) pxNewServer->xPartitionCoreID;
+            }
+            #endif
+
+            if( prvDensityFits( uxQueue, ulDensity ) == pdFALSE )
+            {
+                traceSERVER_ADMISSION_FAILED( pxNewServer );
+
+                #if ( configADMISSION_CONTROL == ADMISSION_CONTROL_REJECT )
+                {
+                    xReturn = pdFAIL;
+                }
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xReturn != pdFAIL )
+            {
+                ulAdmittedDensity[ uxQueue ] += ulDensity;
+                traceSERVER_CREATE( pxNewServer );
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvServerReleaseJob( TCB_t * pxTCB )
+    {
+        TaskServer_t * const pxServer = pxTCB->pxServer;
+        const TickType_t xConstTickCount = xTickCount;
+        const TCB_t * pxOtherTCB;
+        BaseType_t xServerActive = pdFALSE;
+
+        for( pxOtherTCB = pxServer->pxFirstTask; pxOtherTCB != NULL; pxOtherTCB = pxOtherTCB->pxNextServerTask )
+        {
+            if( ( pxOtherTCB != pxTCB ) && ( taskIS_IN_READY_QUEUE( pxOtherTCB ) != pdFALSE ) )
+            {
+                xServerActive = pdTRUE;
+                break;
+            }
+        }
+
+        if( xServerActive == pdFALSE )
+        {
+            /* The budget left over can be kept only if using it up by the
+             * current deadline stays within the bandwidth of the server,
+             * that is remaining / ( deadline - now ) < budget / period. */
+            if( ( taskTICK_IS_BEFORE( xConstTickCount, pxServer->xDeadline ) == pdFALSE ) ||
+                ( ( ( uint64_t ) pxServer->xRemainingBudget * pxServer->xPeriod ) >=
+                  ( ( uint64_t ) ( TickType_t ) ( pxServer->xDeadline - xConstTickCount ) * pxServer->xBudget ) ) )
+            {
+                pxServer->xDeadline = xConstTickCount + pxServer->xPeriod;
+                pxServer->xRemainingBudget = pxServer->xBudget;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxTCB->xReleaseTime = xConstTickCount;
+        pxTCB->uxDeadline = pxServer->xDeadline;
+        pxTCB->xDeadlineMissed = pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvServerChargeTick( TaskServer_t * pxServer )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xSwitchRequired = pdFALSE;
+
+        if( pxServer->xRemainingBudget > ( TickType_t ) 1U )
+        {
+            pxServer->xRemainingBudget--;
+        }
+        else
+        {
+            traceSERVER_BUDGET_EXHAUSTED( pxServer );
+
+            pxServer->xRemainingBudget = pxServer->xBudget;
+            pxServer->xDeadline += pxServer->xPeriod;
+
+            /* The ready tasks of the server move back to the new deadline,
+             * and give up their cores if they no longer have the earliest
+             * one. */
+            for( pxTCB = pxServer->pxFirstTask; pxTCB != NULL; pxTCB = pxTCB->pxNextServerTask )
+            {
+                if( taskIS_IN_READY_QUEUE( pxTCB ) != pdFALSE )
+                {
+                    taskREMOVE_FROM_READY_QUEUE( pxTCB );
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    pxTCB->uxDeadline = pxServer->xDeadline;
+                    pxTCB->xDeadlineMissed = pdFALSE;
+                    prvAddTaskToReadyList( pxTCB );
+
+                    #if ( configNUMBER_OF_CORES == 1 )
+                    {
+                        if( pxTCB == pxCurrentTCB )
+                        {
+                            xSwitchRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #else
+                    {
+                        if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
+                        {
+                            if( pxTCB->xTaskRunState == ( BaseType_t ) portGET_CORE_ID() )
+                            {
+                                xSwitchRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                prvYieldCore( pxTCB->xTaskRunState );
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+
+        return xSwitchRequired;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvServerRemoveTask( const TCB_t * pxTCB )
+    {
+        TCB_t ** ppxLink;
+
+        if( pxTCB->pxServer != NULL )
+        {
+            for( ppxLink = &( pxTCB->pxServer->pxFirstTask ); *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNextServerTask ) )
+            {
+                if( *ppxLink == pxTCB )
+                {
+                    *ppxLink = pxTCB->pxNextServerTask;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* #if ( configEDF_USE_SERVERS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configEDF_PARTITIONED == 1 )
+
+    static void prvPartitionReadyTasks( void )
+    {
+        List_t xUnassignedList;
+        List_t * pxList;
+        TCB_t * pxTCB;
+        UBaseType_t uxQueue;
+        uint32_t ulDensity;
+
+        vListInitialise( &xUnassignedList );
+
+        /* Take every task out of the ready queues, largest density first.
+         * Suspended tasks keep the core they were given when created. */
+        for( uxQueue = 0U; uxQueue < ( UBaseType_t ) taskREADY_QUEUE_COUNT; uxQueue++ )
+        {
+            pxList = pxReadyTaskLists[ uxQueue ];
+
+            for( ; ; )
+            {
+                if( listLIST_IS_EMPTY( pxList ) != pdFALSE )
+                {
+                    if( pxList == pxOverflowReadyTaskLists[ uxQueue ] )
+                    {
+                        break;
+                    }
+
+                    pxList = pxOverflowReadyTaskLists[ uxQueue ];
+                    continue;
+                }
+
+                /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxList );
+
+                taskREMOVE_FROM_READY_QUEUE( pxTCB );
+                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                prvReleaseTask( pxTCB );
+
+                ulDensity = prvTaskDensity( pxTCB );
+
+                if( ulDensity > taskUTILIZATION_ONE )
+                {
+                    ulDensity = taskUTILIZATION_ONE;
+                }
+
+                listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), ( TickType_t ) ( taskUTILIZATION_ONE - ulDensity ) );
+                vListInsert( &xUnassignedList, &( pxTCB->xStateListItem ) );
+            }
+        }
+
+        while( listLIST_IS_EMPTY( &xUnassignedList ) == pdFALSE )
+        {
+            /* MISRA Ref 11.5.3 [Void pointer assignment] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+            /* coverity[misra_c_2012_rule_11_5_violation] */
+            pxTCB = listGET_OWNER_OF_HEAD_ENTRY( &xUnassignedList );
+            listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+
+            /* The tasks were all admitted once already, so are not turned away
+             * if this packing happens to be worse. */
+            ( void ) prvAdmitTask( pxTCB, pdFALSE );
+            listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), pxTCB->uxDeadline );
+            taskINSERT_INTO_READY_QUEUE( pxTCB );
+        }
+    }
+
+#endif /* #if ( configEDF_PARTITIONED == 1 ) */
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 
     static TCB_t * prvCreateStaticTask( TaskFunction_t pxTaskCode,
                                         const char * const pcName,
@@ -1247,6 +2276,56 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
     }
 /*-----------------------------------------------------------*/
 
+    TaskHandle_t xTaskCreatePeriodicStatic( TaskFunction_t pxTaskCode,
+                                            const char * const pcName,
+                                            const configSTACK_DEPTH_TYPE uxStackDepth,
+                                            void * const pvParameters,
+                                            TickType_t xPeriod,
+                                            TickType_t xRelativeDeadline,
+                                            TickType_t xWorstCaseExecutionTime,
+                                            StackType_t * const puxStackBuffer,
+                                            StaticTask_t * const pxTaskBuffer )
+    {
+        TaskHandle_t xReturn = NULL;
+        TCB_t * pxNewTCB;
+
+        traceENTER_xTaskCreatePeriodicStatic( pxTaskCode, pcName, uxStackDepth, pvParameters, xPeriod, xRelativeDeadline, xWorstCaseExecutionTime, puxStackBuffer, pxTaskBuffer );
+
+        configASSERT( xPeriod > ( TickType_t ) 0U );
+        configASSERT( ( xRelativeDeadline > ( TickType_t ) 0U ) && ( xRelativeDeadline != portMAX_DELAY ) );
+
+        pxNewTCB = prvCreateStaticTask( pxTaskCode, pcName, uxStackDepth, pvParameters, xRelativeDeadline, puxStackBuffer, pxTaskBuffer, &xReturn );
+
+        if( pxNewTCB != NULL )
+        {
+            #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+            {
+                /* Set the task's affinity before scheduling it. */
+                pxNewTCB->uxCoreAffinityMask = configTASK_DEFAULT_CORE_AFFINITY;
+            }
+            #endif
+
+            pxNewTCB->xPeriod = xPeriod;
+            pxNewTCB->xWorstCaseExecutionTime = xWorstCaseExecutionTime;
+
+            if( prvAddNewTaskToReadyList( pxNewTCB ) == pdFAIL )
+            {
+                /* The task was not admitted.  The buffers belong to the
+                 * caller, so there is nothing to free. */
+                xReturn = NULL;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xTaskCreatePeriodicStatic( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
     #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
         TaskHandle_t xTaskCreateStaticAffinitySet( TaskFunction_t pxTaskCode,
                                                    const char * const pcName,
@@ -1656,6 +2735,70 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
     }
 /*-----------------------------------------------------------*/
 
+    BaseType_t xTaskCreatePeriodic( TaskFunction_t pxTaskCode,
+                                    const char * const pcName,
+                                    const configSTACK_DEPTH_TYPE uxStackDepth,
+                                    void * const pvParameters,
+                                    TickType_t xPeriod,
+                                    TickType_t xRelativeDeadline,
+                                    TickType_t xWorstCaseExecutionTime,
+                                    TaskHandle_t * const pxCreatedTask )
+    {
+        TCB_t * pxNewTCB;
+        BaseType_t xReturn;
+
+        traceENTER_xTaskCreatePeriodic( pxTaskCode, pcName, uxStackDepth, pvParameters, xPeriod, xRelativeDeadline, xWorstCaseExecutionTime, pxCreatedTask );
+
+        configASSERT( xPeriod > ( TickType_t ) 0U );
+        configASSERT( ( xRelativeDeadline > ( TickType_t ) 0U ) && ( xRelativeDeadline != portMAX_DELAY ) );
+
+        pxNewTCB = prvCreateTask( pxTaskCode, pcName, uxStackDepth, pvParameters, xRelativeDeadline, pxCreatedTask );
+
+        if( pxNewTCB != NULL )
+        {
+            #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+            {
+                /* Set the task's affinity before scheduling it. */
+                pxNewTCB->uxCoreAffinityMask = configTASK_DEFAULT_CORE_AFFINITY;
+            }
+            #endif
+
+            pxNewTCB->xPeriod = xPeriod;
+            pxNewTCB->xWorstCaseExecutionTime = xWorstCaseExecutionTime;
+
+            if( prvAddNewTaskToReadyList( pxNewTCB ) != pdFAIL )
+            {
+                xReturn = pdPASS;
+            }
+            else
+            {
+                #if ( configADMISSION_CONTROL == ADMISSION_CONTROL_REJECT )
+                {
+                    /* The task was not admitted, so was never added to a
+                     * list. */
+                    if( pxCreatedTask != NULL )
+                    {
+                        *pxCreatedTask = NULL;
+                    }
+
+                    prvDeleteTCB( pxNewTCB );
+                }
+                #endif
+
+                xReturn = errTASK_NOT_ADMITTED;
+            }
+        }
+        else
+        {
+            xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+        }
+
+        traceRETURN_xTaskCreatePeriodic( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
     #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
         BaseType_t xTaskCreateAffinitySet( TaskFunction_t pxTaskCode,
                                            const char * const pcName,
@@ -1694,6 +2837,218 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if ( configEDF_USE_READY_HEAP == 1 )
+
+    static void prvReadyHeapPlace( TCB_t * pxTCB,
+                                   UBaseType_t uxIndex )
+    {
+        pxReadyHeaps[ taskREADY_QUEUE( pxTCB ) ][ uxIndex ] = pxTCB;
+        pxTCB->uxReadyHeapIndex = uxIndex + 1U;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvReadyHeapSiftUp( UBaseType_t uxQueue,
+                                    UBaseType_t uxIndex )
+    {
+        TCB_t ** const pxReadyHeap = pxReadyHeaps[ uxQueue ];
+        TCB_t * const pxTCB = pxReadyHeap[ uxIndex ];
+        UBaseType_t uxParent;
+
+        while( uxIndex > 0U )
+        {
+            uxParent = ( uxIndex - 1U ) / 2U;
+
+            if( taskDEADLINE_IS_EARLIER( pxTCB, pxReadyHeap[ uxParent ] ) == pdFALSE )
+            {
+                break;
+            }
+
+            prvReadyHeapPlace( pxReadyHeap[ uxParent ], uxIndex );
+            uxIndex = uxParent;
+        }
+
+        prvReadyHeapPlace( pxTCB, uxIndex );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvReadyHeapSiftDown( UBaseType_t uxQueue,
+                                      UBaseType_t uxIndex )
+    {
+        TCB_t ** const pxReadyHeap = pxReadyHeaps[ uxQueue ];
+        const UBaseType_t uxReadyHeapLength = uxReadyHeapLengths[ uxQueue ];
+        TCB_t * const pxTCB = pxReadyHeap[ uxIndex ];
+        UBaseType_t uxChild;
+
+        for( ; ; )
+        {
+            uxChild = ( uxIndex * 2U ) + 1U;
+
+            if( uxChild >= uxReadyHeapLength )
+            {
+                break;
+            }
+
+            /* Follow the child with the earlier deadline. */
+            if( ( ( uxChild + 1U ) < uxReadyHeapLength ) &&
+                ( taskDEADLINE_IS_EARLIER( pxReadyHeap[ uxChild + 1U ], pxReadyHeap[ uxChild ] ) != pdFALSE ) )
+            {
+                uxChild++;
+            }
+
+            if( taskDEADLINE_IS_EARLIER( pxReadyHeap[ uxChild ], pxTCB ) == pdFALSE )
+            {
+                break;
+            }
+
+            prvReadyHeapPlace( pxReadyHeap[ uxChild ], uxIndex );
+            uxIndex = uxChild;
+        }
+
+        prvReadyHeapPlace( pxTCB, uxIndex );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvReadyHeapInsert( TCB_t * pxTCB )
+    {
+        const UBaseType_t uxQueue = taskREADY_QUEUE( pxTCB );
+
+        /* configEDF_READY_HEAP_LENGTH must be large enough to hold every task
+         * that can be ready at the same time. */
+        configASSERT( uxReadyHeapLengths[ uxQueue ] < ( UBaseType_t ) configEDF_READY_HEAP_LENGTH );
+        configASSERT( pxTCB->uxReadyHeapIndex == 0U );
+
+        pxReadyHeaps[ uxQueue ][ uxReadyHeapLengths[ uxQueue ] ] = pxTCB;
+        uxReadyHeapLengths[ uxQueue ]++;
+        prvReadyHeapSiftUp( uxQueue, uxReadyHeapLengths[ uxQueue ] - 1U );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvReadyHeapRemove( TCB_t * pxTCB )
+    {
+        const UBaseType_t uxQueue = taskREADY_QUEUE( pxTCB );
+        TCB_t ** const pxReadyHeap = pxReadyHeaps[ uxQueue ];
+        const UBaseType_t uxIndex = pxTCB->uxReadyHeapIndex - 1U;
+        TCB_t * pxLastTCB;
+
+        configASSERT( pxReadyHeap[ uxIndex ] == pxTCB );
+
+        pxTCB->uxReadyHeapIndex = 0U;
+        uxReadyHeapLengths[ uxQueue ]--;
+
+        if( uxIndex != uxReadyHeapLengths[ uxQueue ] )
+        {
+            /* Fill the hole with the last task in the heap.  It may need to
+             * move either up or down from there. */
+            pxLastTCB = pxReadyHeap[ uxReadyHeapLengths[ uxQueue ] ];
+            prvReadyHeapPlace( pxLastTCB, uxIndex );
+
+            if( ( uxIndex > 0U ) &&
+                ( taskDEADLINE_IS_EARLIER( pxLastTCB, pxReadyHeap[ ( uxIndex - 1U ) / 2U ] ) != pdFALSE ) )
+            {
+                prvReadyHeapSiftUp( uxQueue, uxIndex );
+            }
+            else
+            {
+                prvReadyHeapSiftDown( uxQueue, uxIndex );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configNUMBER_OF_CORES > 1 )
+
+/* Number of heap positions prvReadyHeapSelectForCore() keeps track of before
+ * it gives up on walking the heap in order and scans the whole heap. */
+        #define taskREADY_HEAP_CANDIDATES    ( ( UBaseType_t ) ( configNUMBER_OF_CORES * 2 ) + 4U )
+
+        static TCB_t * prvReadyHeapSelectForCore( BaseType_t xCoreID )
+        {
+            #if ( configEDF_PARTITIONED == 1 )
+                TCB_t ** const pxReadyHeap = pxReadyHeaps[ xCoreID ];
+                const UBaseType_t uxReadyHeapLength = uxReadyHeapLengths[ xCoreID ];
+            #else
+                TCB_t ** const pxReadyHeap = pxReadyHeaps[ 0 ];
+                const UBaseType_t uxReadyHeapLength = uxReadyHeapLengths[ 0 ];
+            #endif
+            UBaseType_t uxCandidates[ taskREADY_HEAP_CANDIDATES ];
+            UBaseType_t uxCandidateCount = 0U;
+            UBaseType_t uxBest, uxIndex, uxChild, x;
+            BaseType_t xOutOfCandidates = pdFALSE;
+            TCB_t * pxSelectedTCB = NULL;
+
+            /* Visit the heap in deadline order.  The children of a task only
+             * need to be looked at when that task cannot run on this core, which
+             * is at most one task per other core unless affinities get in the
+             * way, so only a handful of positions are ever visited. */
+            if( uxReadyHeapLength > 0U )
+            {
+                uxCandidates[ 0 ] = 0U;
+                uxCandidateCount = 1U;
+            }
+
+            while( ( pxSelectedTCB == NULL ) && ( uxCandidateCount > 0U ) && ( xOutOfCandidates == pdFALSE ) )
+            {
+                uxBest = 0U;
+
+                for( x = 1U; x < uxCandidateCount; x++ )
+                {
+                    if( taskDEADLINE_IS_EARLIER( pxReadyHeap[ uxCandidates[ x ] ], pxReadyHeap[ uxCandidates[ uxBest ] ] ) != pdFALSE )
+                    {
+                        uxBest = x;
+                    }
+                }
+
+                uxIndex = uxCandidates[ uxBest ];
+                uxCandidateCount--;
+                uxCandidates[ uxBest ] = uxCandidates[ uxCandidateCount ];
+
+                if( prvTaskCanRunOnCore( pxReadyHeap[ uxIndex ], xCoreID ) != pdFALSE )
+                {
+                    pxSelectedTCB = pxReadyHeap[ uxIndex ];
+                }
+                else
+                {
+                    for( uxChild = ( uxIndex * 2U ) + 1U; ( uxChild <= ( uxIndex * 2U ) + 2U ) && ( uxChild < uxReadyHeapLength ); uxChild++ )
+                    {
+                        if( uxCandidateCount < taskREADY_HEAP_CANDIDATES )
+                        {
+                            uxCandidates[ uxCandidateCount ] = uxChild;
+                            uxCandidateCount++;
+                        }
+                        else
+                        {
+                            xOutOfCandidates = pdTRUE;
+                        }
+                    }
+                }
+            }
+
+            if( xOutOfCandidates != pdFALSE )
+            {
+                /* Too many tasks were excluded by their affinity, fall back to
+                 * looking at every ready task. */
+                for( x = 0U; x < uxReadyHeapLength; x++ )
+                {
+                    if( ( prvTaskCanRunOnCore( pxReadyHeap[ x ], xCoreID ) != pdFALSE ) &&
+                        ( ( pxSelectedTCB == NULL ) || ( taskDEADLINE_IS_EARLIER( pxReadyHeap[ x ], pxSelectedTCB ) != pdFALSE ) ) )
+                    {
+                        pxSelectedTCB = pxReadyHeap[ x ];
+                    }
+                }
+            }
+
+            return pxSelectedTCB;
+        }
+
+    #endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+
+#endif /* #if ( configEDF_USE_READY_HEAP == 1 ) */
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                                   const char * const pcName,
                                   const configSTACK_DEPTH_TYPE uxStackDepth,
@@ -1792,14 +3147,10 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
         mtCOVERAGE_TEST_MARKER();
     }
 
-    /* This is used as an array index so must ensure it's not too large. */
-
+    /* uxDeadline is relative to the release of each job.  The absolute
+     * deadline is set when the task is added to the ready list. */
+    pxNewTCB->xRelativeDeadline = uxDeadline;
     pxNewTCB->uxDeadline = uxDeadline;
-    #if ( configUSE_MUTEXES == 1 )
-    {
-        pxNewTCB->uxBasePriority = uxPriority;
-    }
-    #endif /* configUSE_MUTEXES */
 
     vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
     vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
@@ -1809,8 +3160,9 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     listSET_LIST_ITEM_VALUE( &( pxNewTCB->xStateListItem ), uxDeadline );
     listSET_LIST_ITEM_OWNER( &( pxNewTCB->xStateListItem ), pxNewTCB );
 
-    /* Event lists are always in priority order. */
-    listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), uxDeadline );
+    /* Event lists are not kept in order, so the value of the event list item
+     * is only used by event groups. */
+    listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) 0U );
     listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
 
     #if ( portUSING_MPU_WRAPPERS == 1 )
@@ -1911,42 +3263,32 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
 #if ( configNUMBER_OF_CORES == 1 )
 
-    static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+    static BaseType_t prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
+        BaseType_t xReturn;
+
         /* Ensure interrupts don't access the task lists while the lists are being
          * updated. */
         taskENTER_CRITICAL();
         {
-            uxCurrentNumberOfTasks = ( UBaseType_t ) ( uxCurrentNumberOfTasks + 1U );
+            xReturn = prvAdmitTask( pxNewTCB, pdTRUE );
 
-            if( pxCurrentTCB == NULL )
+            if( xReturn != pdFAIL )
             {
-                /* There are no other tasks, or all the other tasks are in
-                 * the suspended state - make this the current task. */
-                pxCurrentTCB = pxNewTCB;
+                uxCurrentNumberOfTasks = ( UBaseType_t ) ( uxCurrentNumberOfTasks + 1U );
 
-                if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
-                {
-                    /* This is the first task to be created so do the preliminary
-                     * initialisation required.  We will not recover if this call
-                     * fails, but we will report the failure. */
-                    prvInitialiseTaskLists();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
-            {
-                /* If the scheduler is not already running, make this task the
-                 * current task if it is the highest priority task to be created
-                 * so far. */
-                if( xSchedulerRunning == pdFALSE )
+                if( pxCurrentTCB == NULL )
                 {
-                    if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                    /* There are no other tasks, or all the other tasks are in
+                     * the suspended state - make this the current task. */
+                    pxCurrentTCB = pxNewTCB;
+
+                    if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
                     {
-                        pxCurrentTCB = pxNewTCB;
+                        /* This is the first task to be created so do the preliminary
+                         * initialisation required.  We will not recover if this call
+                         * fails, but we will report the failure. */
+                        prvInitialiseTaskLists();
                     }
                     else
                     {
@@ -1955,27 +3297,45 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* If the scheduler is not already running, make this task the
+                     * current task if it is the highest priority task to be created
+                     * so far. */
+                    if( xSchedulerRunning == pdFALSE )
+                    {
+                        if( taskDEADLINE_IS_EARLIER( pxCurrentTCB, pxNewTCB ) == pdFALSE )
+                        {
+                            pxCurrentTCB = pxNewTCB;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
-            }
 
-            uxTaskNumber++;
+                uxTaskNumber++;
 
-            #if ( configUSE_TRACE_FACILITY == 1 )
-            {
-                /* Add a counter into the TCB for tracing only. */
-                pxNewTCB->uxTCBNumber = uxTaskNumber;
-            }
-            #endif /* configUSE_TRACE_FACILITY */
-            traceTASK_CREATE( pxNewTCB );
+                #if ( configUSE_TRACE_FACILITY == 1 )
+                {
+                    /* Add a counter into the TCB for tracing only. */
+                    pxNewTCB->uxTCBNumber = uxTaskNumber;
+                }
+                #endif /* configUSE_TRACE_FACILITY */
+                traceTASK_CREATE( pxNewTCB );
 
-            prvAddTaskToReadyList( pxNewTCB );
+                taskSTART_JOB( pxNewTCB, xTickCount );
+                prvAddTaskToReadyList( pxNewTCB );
 
-            portSETUP_TCB( pxNewTCB );
+                portSETUP_TCB( pxNewTCB );
+            }
         }
         taskEXIT_CRITICAL();
 
-        if( xSchedulerRunning != pdFALSE )
+        if( ( xReturn != pdFAIL ) && ( xSchedulerRunning != pdFALSE ) )
         {
             /* If the created task is of a higher priority than the current task
              * then it should run now. */
@@ -1985,64 +3345,77 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
         {
             mtCOVERAGE_TEST_MARKER();
         }
+
+        return xReturn;
     }
 
 #else /* #if ( configNUMBER_OF_CORES == 1 ) */
 
-    static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+    static BaseType_t prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
+        BaseType_t xReturn;
+
         /* Ensure interrupts don't access the task lists while the lists are being
          * updated. */
         taskENTER_CRITICAL();
         {
-            uxCurrentNumberOfTasks++;
+            /* With partitioned EDF this also assigns the task to a core. */
+            xReturn = prvAdmitTask( pxNewTCB, pdTRUE );
 
-            if( xSchedulerRunning == pdFALSE )
+            if( xReturn != pdFAIL )
             {
-                if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
-                {
-                    /* This is the first task to be created so do the preliminary
-                     * initialisation required.  We will not recover if this call
-                     * fails, but we will report the failure. */
-                    prvInitialiseTaskLists();
-                }
-                else
+                uxCurrentNumberOfTasks++;
+
+                if( xSchedulerRunning == pdFALSE )
                 {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                    if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+                    {
+                        /* This is the first task to be created so do the preliminary
+                         * initialisation required.  We will not recover if this call
+                         * fails, but we will report the failure. */
+                        prvInitialiseTaskLists();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-                /* All the cores start with idle tasks before the SMP scheduler
-                 * is running. Idle tasks are assigned to cores when they are
-                 * created in prvCreateIdleTasks(). */
-            }
+                    /* All the cores start with idle tasks before the SMP scheduler
+                     * is running. Idle tasks are assigned to cores when they are
+                     * created in prvCreateIdleTasks(). */
+                }
 
-            uxTaskNumber++;
+                uxTaskNumber++;
 
-            #if ( configUSE_TRACE_FACILITY == 1 )
-            {
-                /* Add a counter into the TCB for tracing only. */
-                pxNewTCB->uxTCBNumber = uxTaskNumber;
-            }
-            #endif /* configUSE_TRACE_FACILITY */
-            traceTASK_CREATE( pxNewTCB );
+                #if ( configUSE_TRACE_FACILITY == 1 )
+                {
+                    /* Add a counter into the TCB for tracing only. */
+                    pxNewTCB->uxTCBNumber = uxTaskNumber;
+                }
+                #endif /* configUSE_TRACE_FACILITY */
+                traceTASK_CREATE( pxNewTCB );
 
-            prvAddTaskToReadyList( pxNewTCB );
+                taskSTART_JOB( pxNewTCB, xTickCount );
+                prvAddTaskToReadyList( pxNewTCB );
 
-            portSETUP_TCB( pxNewTCB );
+                portSETUP_TCB( pxNewTCB );
 
-            if( xSchedulerRunning != pdFALSE )
-            {
-                /* If the created task is of a higher priority than another
-                 * currently running task and preemption is on then it should
-                 * run now. */
-                taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxNewTCB );
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
+                if( xSchedulerRunning != pdFALSE )
+                {
+                    /* If the created task is of a higher priority than another
+                     * currently running task and preemption is on then it should
+                     * run now. */
+                    taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxNewTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
         }
         taskEXIT_CRITICAL();
+
+        return xReturn;
     }
 
 #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
@@ -2099,6 +3472,8 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             configASSERT( pxTCB != NULL );
 
             /* Remove task from the ready/delayed list. */
+            taskREMOVE_FROM_READY_QUEUE( pxTCB );
+
             if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
             {
                 taskRESET_READY_PRIORITY( pxTCB->uxPriority );
@@ -2118,6 +3493,14 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            prvReleaseTask( pxTCB );
+
+            #if ( configEDF_USE_SERVERS == 1 )
+            {
+                prvServerRemoveTask( pxTCB );
+            }
+            #endif
+
             /* Increment the uxTaskNumber also so kernel aware debuggers can
              * detect that the task lists need re-generating.  This is done before
              * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -2376,6 +3759,271 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 #endif /* INCLUDE_vTaskDelay */
 /*-----------------------------------------------------------*/
 
+void vTaskWaitForNextPeriod( void )
+{
+    TickType_t xNextRelease;
+    BaseType_t xAlreadyYielded;
+
+    traceENTER_vTaskWaitForNextPeriod();
+
+    /* Only tasks created with xTaskCreatePeriodic() have a period. */
+    configASSERT( pxCurrentTCB->xPeriod > ( TickType_t ) 0U );
+
+    vTaskSuspendAll();
+    {
+        /* Minor optimisation.  The tick count cannot change in this
+         * block. */
+        const TickType_t xConstTickCount = xTickCount;
+
+        /* The next job is released one period after the current one, not one
+         * period after now, so the releases do not drift however long each
+         * job takes. */
+        xNextRelease = pxCurrentTCB->xReleaseTime + pxCurrentTCB->xPeriod;
+        taskSTART_JOB( pxCurrentTCB, xNextRelease );
+
+        if( taskTICK_IS_BEFORE( xConstTickCount, xNextRelease ) != pdFALSE )
+        {
+            traceTASK_DELAY_UNTIL( xNextRelease );
+
+            /* The task is placed back in the ready list with its new deadline
+             * when it is unblocked. */
+            prvAddCurrentTaskToDelayedList( xNextRelease - xConstTickCount, pdFALSE );
+        }
+        else
+        {
+            /* The job overran its period so the next job has already been
+             * released.  The task stays ready, but has to be moved to the
+             * position of its new deadline. */
+            taskREMOVE_FROM_READY_QUEUE( pxCurrentTCB );
+            ( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+            prvAddTaskToReadyList( pxCurrentTCB );
+        }
+    }
+    xAlreadyYielded = xTaskResumeAll();
+
+    /* Force a reschedule if xTaskResumeAll has not already done so, we may
+     * have put ourselves to sleep. */
+    if( xAlreadyYielded == pdFALSE )
+    {
+        taskYIELD_WITHIN_API();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceRETURN_vTaskWaitForNextPeriod();
+}
+/*-----------------------------------------------------------*/
+
+int32_t lTaskGetAdmissionHeadroom( BaseType_t xCoreID )
+{
+    int32_t lHeadroom;
+
+    traceENTER_lTaskGetAdmissionHeadroom( xCoreID );
+
+    #if ( configEDF_PARTITIONED == 1 )
+    {
+        configASSERT( taskVALID_CORE_ID( xCoreID ) == pdTRUE );
+    }
+    #else
+    {
+        ( void ) xCoreID;
+        xCoreID = ( BaseType_t ) 0;
+    }
+    #endif
+
+    /* The densities are only changed in critical sections. */
+    taskENTER_CRITICAL();
+    {
+        lHeadroom = ( int32_t ) taskADMISSION_BOUND - ( int32_t ) ulAdmittedDensity[ xCoreID ];
+    }
+    taskEXIT_CRITICAL();
+
+    traceRETURN_lTaskGetAdmissionHeadroom( lHeadroom );
+
+    return lHeadroom;
+}
+/*-----------------------------------------------------------*/
+
+#if ( ( configEDF_USE_SERVERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    TaskServerHandle_t xTaskCreateServerStatic( TickType_t xBudget,
+                                                TickType_t xPeriod,
+                                                StaticTaskServer_t * const pxServerBuffer )
+    {
+        TaskServer_t * pxNewServer = NULL;
+
+        traceENTER_xTaskCreateServerStatic( xBudget, xPeriod, pxServerBuffer );
+
+        configASSERT( pxServerBuffer != NULL );
+        configASSERT( ( xBudget > ( TickType_t ) 0U ) && ( xBudget <= xPeriod ) );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticTaskServer_t equals the size of the real
+             * server structure. */
+            volatile size_t xSize = sizeof( StaticTaskServer_t );
+            configASSERT( xSize == sizeof( TaskServer_t ) );
+            ( void ) xSize; /* Prevent unused variable warning when configASSERT() is not used. */
+        }
+        #endif /* configASSERT_DEFINED */
+
+        if( pxServerBuffer != NULL )
+        {
+            /* MISRA Ref 11.3.1 [Misaligned access] */
+            /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-113 */
+            /* coverity[misra_c_2012_rule_11_3_violation] */
+            pxNewServer = ( TaskServer_t * ) pxServerBuffer;
+
+            if( prvInitialiseNewServer( xBudget, xPeriod, pxNewServer ) == pdFAIL )
+            {
+                pxNewServer = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xTaskCreateServerStatic( pxNewServer );
+
+        return pxNewServer;
+    }
+
+#endif /* #if ( ( configEDF_USE_SERVERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configEDF_USE_SERVERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    TaskServerHandle_t xTaskCreateServer( TickType_t xBudget,
+                                          TickType_t xPeriod )
+    {
+        TaskServer_t * pxNewServer;
+
+        traceENTER_xTaskCreateServer( xBudget, xPeriod );
+
+        configASSERT( ( xBudget > ( TickType_t ) 0U ) && ( xBudget <= xPeriod ) );
+
+        /* MISRA Ref 11.5.1 [Malloc memory assignment] */
+        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+        /* coverity[misra_c_2012_rule_11_5_violation] */
+        pxNewServer = ( TaskServer_t * ) pvPortMalloc( sizeof( TaskServer_t ) );
+
+        if( pxNewServer != NULL )
+        {
+            if( prvInitialiseNewServer( xBudget, xPeriod, pxNewServer ) == pdFAIL )
+            {
+                vPortFree( pxNewServer );
+                pxNewServer = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xTaskCreateServer( pxNewServer );
+
+        return pxNewServer;
+    }
+
+#endif /* #if ( ( configEDF_USE_SERVERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configEDF_USE_SERVERS == 1 )
+
+    void vTaskSetServer( TaskHandle_t xTask,
+                         TaskServerHandle_t xServer )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xWasReady = pdFALSE;
+
+        traceENTER_vTaskSetServer( xTask, xServer );
+
+        configASSERT( xServer != NULL );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            configASSERT( pxTCB != NULL );
+
+            /* A periodic task has its own deadlines, and a task can only take
+             * the deadline of one server. */
+            configASSERT( pxTCB->xPeriod == ( TickType_t ) 0U );
+            configASSERT( pxTCB->pxServer == NULL );
+
+            /* A task without a deadline is ready in xIdleTaskList rather
+             * than a ready queue. */
+            if( ( listIS_CONTAINED_WITHIN( &xIdleTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE ) ||
+                ( ( taskIS_BACKGROUND_TASK( pxTCB ) == pdFALSE ) && ( taskIS_IN_READY_QUEUE( pxTCB ) != pdFALSE ) ) )
+            {
+                taskREMOVE_FROM_READY_QUEUE( pxTCB );
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                xWasReady = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvReleaseTask( pxTCB );
+
+            pxTCB->xRelativeDeadline = xServer->xPeriod;
+            pxTCB->pxServer = xServer;
+            pxTCB->pxNextServerTask = xServer->pxFirstTask;
+            xServer->pxFirstTask = pxTCB;
+
+            /* The server has already been admitted. */
+            ( void ) prvAdmitTask( pxTCB, pdFALSE );
+
+            if( xWasReady != pdFALSE )
+            {
+                /* The task arrives at the server as though it had just been
+                 * released. */
+                taskRELEASE_JOB( pxTCB );
+                prvAddTaskToReadyList( pxTCB );
+
+                if( xSchedulerRunning != pdFALSE )
+                {
+                    if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
+                    {
+                        /* The deadline of the task has changed, so it has to
+                         * be chosen again. */
+                        taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB );
+                    }
+                    else
+                    {
+                        taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxTCB );
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_vTaskSetServer();
+    }
+
+#endif /* #if ( configEDF_USE_SERVERS == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
 
     eTaskState eTaskGetState( TaskHandle_t xTask )
@@ -2893,7 +4541,36 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             pxTCB = prvGetTCBFromHandle( xTask );
             configASSERT( pxTCB != NULL );
 
-            pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+            #if ( configEDF_PARTITIONED == 1 )
+            {
+                /* Move the task to a core in its new affinity.  A ready task
+                 * has to move to the ready queue of that core too. */
+                BaseType_t xWasReady = pdFALSE;
+
+                if( ( taskIS_BACKGROUND_TASK( pxTCB ) == pdFALSE ) && ( taskIS_IN_READY_QUEUE( pxTCB ) != pdFALSE ) )
+                {
+                    taskREMOVE_FROM_READY_QUEUE( pxTCB );
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    xWasReady = pdTRUE;
+                }
+
+                /* The task is already running, so is not turned away if the
+                 * new core does not have room for it. */
+                prvReleaseTask( pxTCB );
+                pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+                ( void ) prvAdmitTask( pxTCB, pdFALSE );
+
+                if( xWasReady != pdFALSE )
+                {
+                    listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), pxTCB->uxDeadline );
+                    taskINSERT_INTO_READY_QUEUE( pxTCB );
+                }
+            }
+            #else /* if ( configEDF_PARTITIONED == 1 ) */
+            {
+                pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+            }
+            #endif /* if ( configEDF_PARTITIONED == 1 ) */
 
             if( xSchedulerRunning != pdFALSE )
             {
@@ -2907,6 +4584,15 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                     {
                         prvYieldCore( xCoreID );
                     }
+
+                    #if ( configEDF_PARTITIONED == 1 )
+                        else if( ( taskIS_BACKGROUND_TASK( pxTCB ) == pdFALSE ) && ( pxTCB->xPartitionCoreID != xCoreID ) )
+                        {
+                            /* The task was moved to another core, this core has
+                             * to give it up before the other one can run it. */
+                            prvYieldCore( xCoreID );
+                        }
+                    #endif
                 }
                 else
                 {
@@ -3036,6 +4722,8 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
             /* Remove task from the ready/delayed list and place in the
              * suspended list. */
+            taskREMOVE_FROM_READY_QUEUE( pxTCB );
+
             if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
             {
                 taskRESET_READY_PRIORITY( pxTCB->uxPriority );
@@ -3285,6 +4973,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                     /* The ready list can be accessed even if the scheduler is
                      * suspended because this is inside a critical section. */
                     ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    taskRELEASE_JOB( pxTCB );
                     prvAddTaskToReadyList( pxTCB );
 
                     /* This yield may not cause the task just resumed to run,
@@ -3350,6 +5039,8 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             {
                 traceTASK_RESUME_FROM_ISR( pxTCB );
 
+                taskRELEASE_JOB( pxTCB );
+
                 /* Check the ready lists can be accessed. */
                 if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
                 {
@@ -3357,7 +5048,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                     {
                         /* Ready lists can be accessed so move the task from the
                          * suspended list to the ready list directly. */
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        if( taskPREEMPTS_CURRENT_TASK( pxTCB ) != pdFALSE )
                         {
                             xYieldRequired = pdTRUE;
 
@@ -3599,6 +5290,14 @@ void vTaskStartScheduler( void )
         }
         #endif
 
+        #if ( configEDF_PARTITIONED == 1 )
+        {
+            /* All the tasks created so far are known now, so they can be
+             * packed onto the cores properly. */
+            prvPartitionReadyTasks();
+        }
+        #endif
+
         /* Interrupts are turned off here, to ensure a tick does not occur
          * before or during the call to xPortStartScheduler().  The stacks of
          * the created tasks contain a status word with interrupts switched on
@@ -3822,55 +5521,36 @@ void vTaskSuspendAll( void )
     static TickType_t prvGetExpectedIdleTime( void )
     {
         TickType_t xReturn;
-        BaseType_t xHigherPriorityReadyTasks = pdFALSE;
+        UBaseType_t uxQueue;
+        BaseType_t xDeadlineTasksReady = pdFALSE;
 
-        /* xHigherPriorityReadyTasks takes care of the case where
-         * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
-         * task that are in the Ready state, even though the idle task is
-         * running. */
-        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+        /* A ready task with a deadline needs every tick to check it against
+         * its deadline.  With configUSE_PREEMPTION set to 0 one can be ready
+         * while the idle task runs. */
+        for( uxQueue = ( UBaseType_t ) 0U; uxQueue < ( UBaseType_t ) taskREADY_QUEUE_COUNT; uxQueue++ )
         {
-            if( uxTopReadyPriority > tskIDLE_PRIORITY )
+            if( taskGET_EARLIEST_DEADLINE_TASK( uxQueue ) != NULL )
             {
-                xHigherPriorityReadyTasks = pdTRUE;
+                xDeadlineTasksReady = pdTRUE;
             }
         }
-        #else
-        {
-            const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
-
-            /* When port optimised task selection is used the uxTopReadyPriority
-             * variable is used as a bit map.  If bits other than the least
-             * significant bit are set then there are tasks that have a priority
-             * above the idle priority that are in the Ready state.  This takes
-             * care of the case where the co-operative scheduler is in use. */
-            if( uxTopReadyPriority > uxLeastSignificantBit )
-            {
-                xHigherPriorityReadyTasks = pdTRUE;
-            }
-        }
-        #endif /* if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) */
 
-        if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
-        {
-            xReturn = 0;
-        }
-        else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > 1U )
+        if( xDeadlineTasksReady != pdFALSE )
         {
-            /* There are other idle priority tasks in the ready state.  If
-             * time slicing is used then the very next tick interrupt must be
-             * processed. */
             xReturn = 0;
         }
-        else if( xHigherPriorityReadyTasks != pdFALSE )
+        else if( listCURRENT_LIST_LENGTH( &xIdleTaskList ) > ( UBaseType_t ) configNUMBER_OF_CORES )
         {
-            /* There are tasks in the Ready state that have a priority above the
-             * idle priority.  This path can only be reached if
-             * configUSE_PREEMPTION is 0. */
+            /* There are background tasks in the ready state beside the idle
+             * tasks.  They share the idle list, so the very next tick
+             * interrupt must be processed. */
             xReturn = 0;
         }
         else
         {
+            /* Nothing is ready, so the next thing EDF has to do is release a
+             * job or unblock a task, and no deadline can be missed before
+             * then. */
             xReturn = xNextTaskUnblockTime;
             xReturn -= xTickCount;
         }
@@ -3929,7 +5609,7 @@ BaseType_t xTaskResumeAll( void )
                         {
                             /* If the moved task has a priority higher than the current
                              * task then a yield must be performed. */
-                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                            if( taskPREEMPTS_CURRENT_TASK( pxTCB ) != pdFALSE )
                             {
                                 xYieldPendings[ xCoreID ] = pdTRUE;
                             }
@@ -4189,8 +5869,8 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
 
     TaskHandle_t xTaskGetHandle( const char * pcNameToQuery )
     {
-        UBaseType_t uxQueue = configMAX_PRIORITIES;
-        TCB_t * pxTCB;
+        UBaseType_t uxQueue;
+        TCB_t * pxTCB = NULL;
 
         traceENTER_xTaskGetHandle( pcNameToQuery );
 
@@ -4200,8 +5880,20 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
         vTaskSuspendAll();
         {
             /* Search the ready lists. */
-            //TODO: Overflow
-            pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxReadyTaskList, pcNameToQuery );
+            for( uxQueue = 0U; ( uxQueue < ( UBaseType_t ) taskREADY_QUEUE_COUNT ) && ( pxTCB == NULL ); uxQueue++ )
+            {
+                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxReadyTaskLists[ uxQueue ], pcNameToQuery );
+
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowReadyTaskLists[ uxQueue ], pcNameToQuery );
+                }
+            }
+
+            if( pxTCB == NULL )
+            {
+                pxTCB = prvSearchForNameWithinSingleList( &xIdleTaskList, pcNameToQuery );
+            }
 
             /* Search the delayed lists. */
             if( pxTCB == NULL )
@@ -4305,7 +5997,7 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
                                       const UBaseType_t uxArraySize,
                                       configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
     {
-        UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+        UBaseType_t uxTask = 0, uxQueue;
 
         traceENTER_uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, pulTotalRunTime );
 
@@ -4316,8 +6008,13 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
             {
                 /* Fill in an TaskStatus_t structure with information on each
                  * task in the Ready state. */
-                uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxReadyTaskList, eReady ) );
-                uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowReadyTaskList, eReady ) );
+                for( uxQueue = 0U; uxQueue < ( UBaseType_t ) taskREADY_QUEUE_COUNT; uxQueue++ )
+                {
+                    uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxReadyTaskLists[ uxQueue ], eReady ) );
+                    uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowReadyTaskLists[ uxQueue ], eReady ) );
+                }
+
+                uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xIdleTaskList, eReady ) );
 
                 /* Fill in an TaskStatus_t structure with information on each
                  * task in the Blocked state. */
@@ -4534,6 +6231,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                 taskEXIT_CRITICAL();
 
                 /* Place the unblocked task into the appropriate ready list. */
+                taskRELEASE_JOB( pxTCB );
                 prvAddTaskToReadyList( pxTCB );
 
                 /* A task being unblocked cannot cause an immediate context
@@ -4545,7 +6243,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                         /* Preemption is on, but a context switch should only be
                          * performed if the unblocked task has a priority that is
                          * higher than the currently executing task. */
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        if( taskPREEMPTS_CURRENT_TASK( pxTCB ) != pdFALSE )
                         {
                             /* Pend the yield to be performed when the scheduler
                              * is unsuspended. */
@@ -4587,6 +6285,7 @@ BaseType_t xTaskIncrementTick( void )
 {
     TCB_t * pxTCB;
     TickType_t xItemValue;
+    UBaseType_t uxQueue;
     BaseType_t xSwitchRequired = pdFALSE;
 
     traceENTER_xTaskIncrementTick();
@@ -4613,6 +6312,7 @@ BaseType_t xTaskIncrementTick( void )
         if( xConstTickCount == ( TickType_t ) 0U )
         {
             taskSWITCH_DELAYED_LISTS();
+            taskSWITCH_READY_LISTS();
         }
         else
         {
@@ -4680,6 +6380,7 @@ BaseType_t xTaskIncrementTick( void )
 
                     /* Place the unblocked task into the appropriate ready
                      * list. */
+                    taskRELEASE_JOB( pxTCB );
                     prvAddTaskToReadyList( pxTCB );
 
                     /* A task being unblocked cannot cause an immediate
@@ -4688,7 +6389,7 @@ BaseType_t xTaskIncrementTick( void )
                     {
                         #if ( configNUMBER_OF_CORES == 1 )
                         {
-                            if( pxTCB->uxDeadline < pxCurrentTCB->uxDeadline )
+                            if( taskPREEMPTS_CURRENT_TASK( pxTCB ) != pdFALSE )
                             {
                                 xSwitchRequired = pdTRUE;
                             }
@@ -4708,6 +6409,84 @@ BaseType_t xTaskIncrementTick( void )
             }
         }
 
+        #if ( configEDF_USE_SERVERS == 1 )
+        {
+            /* The task that ran for the tick that has just ended uses up the
+             * budget of its server. */
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                if( pxCurrentTCB->pxServer != NULL )
+                {
+                    if( prvServerChargeTick( pxCurrentTCB->pxServer ) != pdFALSE )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #else /* if ( configNUMBER_OF_CORES == 1 ) */
+            {
+                BaseType_t xCoreID;
+
+                for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    pxTCB = pxCurrentTCBs[ xCoreID ];
+
+                    if( pxTCB->pxServer != NULL )
+                    {
+                        if( prvServerChargeTick( pxTCB->pxServer ) != pdFALSE )
+                        {
+                            xSwitchRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+        }
+        #endif /* if ( configEDF_USE_SERVERS == 1 ) */
+
+        /* Only the earliest deadline in each ready queue is checked, so finding
+         * a miss costs O(1) per tick.  A later job that has also missed its
+         * deadline is found once it reaches the head of the queue. */
+        for( uxQueue = ( UBaseType_t ) 0U; uxQueue < ( UBaseType_t ) taskREADY_QUEUE_COUNT; uxQueue++ )
+        {
+            pxTCB = taskGET_EARLIEST_DEADLINE_TASK( uxQueue );
+
+            if( ( pxTCB != NULL ) &&
+                ( taskIS_BACKGROUND_TASK( pxTCB ) == pdFALSE ) &&
+                ( pxTCB->xDeadlineMissed == pdFALSE ) &&
+                ( taskTICK_IS_BEFORE( xConstTickCount, pxTCB->uxDeadline ) == pdFALSE ) )
+            {
+                if( prvDeadlineMissed( pxTCB, xConstTickCount ) != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
         #if ( configUSE_TICK_HOOK == 1 )
         {
             /* Guard against the tick hook being called when the pended tick
@@ -5120,18 +6899,16 @@ void vTaskPlaceOnEventList( List_t * const pxEventList,
     /* THIS FUNCTION MUST BE CALLED WITH THE
      * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
 
-    /* Place the event list item of the TCB in the appropriate event list.
-     * This is placed in the list in priority order so the highest priority task
-     * is the first to be woken by the event.
-     *
-     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
-     * Normally, the xItemValue of a TCB's ListItem_t members is:
-     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
-     * Therefore, the event list is sorted in descending priority order.
+    /* Place the event list item of the TCB at the end of the appropriate event
+     * list.  A task that is not periodic starts a new job when it is woken, so
+     * which waiter has the earliest deadline depends on when the event occurs.
+     * xTaskRemoveFromEventList() therefore picks the waiter when it does, and
+     * the list is only kept in the order the tasks blocked in, which settles
+     * ties between equal deadlines.
      *
      * The queue that contains the event list is locked, preventing
      * simultaneous access from interrupts. */
-    vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+    listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
 
     prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
 
@@ -5218,9 +6995,8 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
     /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
      * called from a critical section within an ISR. */
 
-    /* The event list is sorted in priority order, so the first in the list can
-     * be removed as it is known to be the highest priority.  Remove the TCB from
-     * the delayed list, and add it to the ready list.
+    /* Wake the waiter that will have the earliest deadline once released.
+     * Remove the TCB from the delayed list, and add it to the ready list.
      *
      * If an event is for a queue that is locked then this function will never
      * get called - the lock count on the queue will get modified instead.  This
@@ -5228,12 +7004,10 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
      *
      * This function assumes that a check has already been made to ensure that
      * pxEventList is not empty. */
-    /* MISRA Ref 11.5.3 [Void pointer assignment] */
-    /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
-    /* coverity[misra_c_2012_rule_11_5_violation] */
-    pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList );
+    pxUnblockedTCB = prvGetEarliestDeadlineWaiter( pxEventList );
     configASSERT( pxUnblockedTCB );
     listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+    taskRELEASE_JOB( pxUnblockedTCB );
 
     if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
     {
@@ -5263,7 +7037,7 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
 
     #if ( configNUMBER_OF_CORES == 1 )
     {
-        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) != pdFALSE )
         {
             /* Return true if the task removed from the event list has a higher
              * priority than the calling task.  This allows the calling task to know if
@@ -5342,11 +7116,12 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
      * scheduler is suspended so interrupts will not be accessing the ready
      * lists. */
     listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+    taskRELEASE_JOB( pxUnblockedTCB );
     prvAddTaskToReadyList( pxUnblockedTCB );
 
     #if ( configNUMBER_OF_CORES == 1 )
     {
-        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+        if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) != pdFALSE )
         {
             /* The unblocked task has a priority above that of the calling task, so
              * a context switch is required.  This function is called with the
@@ -5883,9 +7658,26 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 
 static void prvInitialiseTaskLists( void )
 {
+    UBaseType_t uxQueue;
+
     vListInitialise( &xIdleTaskList );
-    vListInitialise( &xReadyTaskList1 );
-    vListInitialise( &xReadyTaskList2 );
+
+    for( uxQueue = 0U; uxQueue < ( UBaseType_t ) taskREADY_QUEUE_COUNT; uxQueue++ )
+    {
+        vListInitialise( &( xReadyTaskLists1[ uxQueue ] ) );
+        vListInitialise( &( xReadyTaskLists2[ uxQueue ] ) );
+
+        /* Start with the ready list using list1 and the overflow ready list
+         * using list2. */
+        pxReadyTaskLists[ uxQueue ] = &( xReadyTaskLists1[ uxQueue ] );
+        pxOverflowReadyTaskLists[ uxQueue ] = &( xReadyTaskLists2[ uxQueue ] );
+
+        #if ( configEDF_USE_READY_HEAP == 1 )
+        {
+            uxReadyHeapLengths[ uxQueue ] = ( UBaseType_t ) 0U;
+        }
+        #endif
+    }
 
     vListInitialise( &xDelayedTaskList1 );
     vListInitialise( &xDelayedTaskList2 );
@@ -5903,8 +7695,6 @@ static void prvInitialiseTaskLists( void )
     }
     #endif /* INCLUDE_vTaskSuspend */
 
-    pxReadyTaskList = &xReadyTaskList1;
-
     /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
      * using list2. */
     pxDelayedTaskList = &xDelayedTaskList1;
@@ -6012,6 +7802,7 @@ static void prvCheckTasksWaitingTermination( void )
             pxTaskStatus->pxEndOfStack = pxTCB->pxEndOfStack;
         #endif
         pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
+        pxTaskStatus->uxDeadlineMisses = pxTCB->uxDeadlineMisses;
 
         #if ( ( configUSE_CORE_AFFINITY == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
         {
@@ -6273,7 +8064,7 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_uxTaskGetStackHighWaterMark */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelete == 1 )
+#if ( ( INCLUDE_vTaskDelete == 1 ) || ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configADMISSION_CONTROL == ADMISSION_CONTROL_REJECT ) ) )
 
     static void prvDeleteTCB( TCB_t * pxTCB )
     {
@@ -6452,91 +8243,91 @@ static void prvResetNextTaskUnblockTime( void )
 
 #if ( configUSE_MUTEXES == 1 )
 
-    BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+    static TCB_t * prvSelectTaskUnderCeiling( TCB_t * pxEarliestTCB )
     {
-        TCB_t * const pxMutexHolderTCB = pxMutexHolder;
-        BaseType_t xReturn = pdFALSE;
+        const ListItem_t * pxEndMarker;
+        ListItem_t * pxIterator;
+        TCB_t * pxTCB;
+        TCB_t * pxSelectedTCB = NULL;
 
-        traceENTER_xTaskPriorityInherit( pxMutexHolder );
+        #if ( configEDF_USE_READY_HEAP == 1 )
+            UBaseType_t x;
+        #else
+            List_t * pxList;
+            BaseType_t x;
+        #endif
 
-        /* If the mutex is taken by an interrupt, the mutex holder is NULL. Priority
-         * inheritance is not applied in this scenario. */
-        if( pxMutexHolder != NULL )
+        if( ( pxEarliestTCB != NULL ) && ( taskPASSES_SYSTEM_CEILING( pxEarliestTCB ) != pdFALSE ) )
+        {
+            pxSelectedTCB = pxEarliestTCB;
+        }
+        else if( pxEarliestTCB != NULL )
         {
-            /* If the holder of the mutex has a priority below the priority of
-             * the task attempting to obtain the mutex then it will temporarily
-             * inherit the priority of the task attempting to obtain the mutex. */
-            if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+            #if ( configEDF_USE_READY_HEAP == 1 )
             {
-                /* Adjust the mutex holder state to account for its new
-                 * priority.  Only reset the event list item value if the value is
-                 * not being used for anything else. */
-                if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == ( ( TickType_t ) 0U ) )
-                {
-                    listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority );
-                }
-                else
+                /* The heap is only in order from its root, so look at every
+                 * ready task.  This is only done while a mutex is held. */
+                for( x = 0U; x < uxReadyHeapLengths[ 0 ]; x++ )
                 {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                    pxTCB = pxReadyHeaps[ 0 ][ x ];
 
-                /* If the task being modified is in the ready state it will need
-                 * to be moved into a new list. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
-                {
-                    if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                    {
-                        /* It is known that the task is in its ready list so
-                         * there is no need to check again and the port level
-                         * reset macro can be called directly. */
-                        portRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority, uxTopReadyPriority );
-                    }
-                    else
+                    if( ( taskPASSES_SYSTEM_CEILING( pxTCB ) != pdFALSE ) &&
+                        ( ( pxSelectedTCB == NULL ) || ( taskDEADLINE_IS_EARLIER( pxTCB, pxSelectedTCB ) != pdFALSE ) ) )
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        pxSelectedTCB = pxTCB;
                     }
+                }
+            }
+            #else /* if ( configEDF_USE_READY_HEAP == 1 ) */
+            {
+                /* The ready list comes before the overflow ready list and both
+                 * are in deadline order, so the first task that passes is the
+                 * one to use. */
+                for( x = 0; ( x < 2 ) && ( pxSelectedTCB == NULL ); x++ )
+                {
+                    pxList = ( x == 0 ) ? pxReadyTaskLists[ 0 ] : pxOverflowReadyTaskLists[ 0 ];
+                    pxEndMarker = listGET_END_MARKER( pxList );
 
-                    /* Inherit the priority before being moved into the new list. */
-                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-                    prvAddTaskToReadyList( pxMutexHolderTCB );
-                    #if ( configNUMBER_OF_CORES > 1 )
+                    for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
                     {
-                        /* The priority of the task is raised. Yield for this task
-                         * if it is not running. */
-                        if( taskTASK_IS_RUNNING( pxMutexHolderTCB ) != pdTRUE )
+                        /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                        /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                        /* coverity[misra_c_2012_rule_11_5_violation] */
+                        pxTCB = listGET_LIST_ITEM_OWNER( pxIterator );
+
+                        if( taskPASSES_SYSTEM_CEILING( pxTCB ) != pdFALSE )
                         {
-                            prvYieldForTask( pxMutexHolderTCB );
+                            pxSelectedTCB = pxTCB;
+                            break;
                         }
                     }
-                    #endif /* if ( configNUMBER_OF_CORES > 1 ) */
-                }
-                else
-                {
-                    /* Just inherit the priority. */
-                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
                 }
+            }
+            #endif /* if ( configEDF_USE_READY_HEAP == 1 ) */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-                traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+        if( pxSelectedTCB == NULL )
+        {
+            /* A task without a deadline can hold a mutex too.  It has to run
+             * ahead of the idle task, or the tasks the ceiling keeps out would
+             * be waiting for nothing. */
+            pxEndMarker = listGET_END_MARKER( &xIdleTaskList );
 
-                /* Inheritance occurred. */
-                xReturn = pdTRUE;
-            }
-            else
+            for( pxIterator = listGET_HEAD_ENTRY( &xIdleTaskList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
             {
-                if( pxMutexHolderTCB->uxBasePriority < pxCurrentTCB->uxPriority )
-                {
-                    /* The base priority of the mutex holder is lower than the
-                     * priority of the task attempting to take the mutex, but the
-                     * current priority of the mutex holder is not lower than the
-                     * priority of the task attempting to take the mutex.
-                     * Therefore the mutex holder must have already inherited a
-                     * priority, but inheritance would have occurred if that had
-                     * not been the case. */
-                    xReturn = pdTRUE;
-                }
-                else
+                /* MISRA Ref 11.5.3 [Void pointer assignment] */
+                /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
+                /* coverity[misra_c_2012_rule_11_5_violation] */
+                pxTCB = listGET_LIST_ITEM_OWNER( pxIterator );
+
+                if( pxTCB->uxMutexesHeld != ( UBaseType_t ) 0U )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    pxSelectedTCB = pxTCB;
+                    break;
                 }
             }
         }
@@ -6545,9 +8336,28 @@ static void prvResetNextTaskUnblockTime( void )
             mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_xTaskPriorityInherit( xReturn );
+        return pxSelectedTCB;
+    }
 
-        return xReturn;
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+    {
+        traceENTER_xTaskPriorityInherit( pxMutexHolder );
+
+        /* Nothing is inherited under the Stack Resource Policy.  A task can
+         * only find a mutex held if the ceiling of the mutex is above its
+         * relative deadline, or if the holder blocked while holding it, and the
+         * holder already runs ahead of every task the system ceiling keeps
+         * out. */
+        ( void ) pxMutexHolder;
+
+        traceRETURN_xTaskPriorityInherit( pdFALSE );
+
+        return pdFALSE;
     }
 
 #endif /* configUSE_MUTEXES */
@@ -6558,90 +8368,28 @@ static void prvResetNextTaskUnblockTime( void )
     BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
     {
         TCB_t * const pxTCB = pxMutexHolder;
-        BaseType_t xReturn = pdFALSE;
 
         traceENTER_xTaskPriorityDisinherit( pxMutexHolder );
 
         if( pxMutexHolder != NULL )
         {
-            /* A task can only have an inherited priority if it holds the mutex.
-             * If the mutex is held by a task then it cannot be given from an
-             * interrupt, and if a mutex is given by the holding task then it must
-             * be the running state task. */
+            /* If the mutex is held by a task then it cannot be given from an
+             * interrupt, and if a mutex is given by the holding task then it
+             * must be the running state task. */
             configASSERT( pxTCB == pxCurrentTCB );
             configASSERT( pxTCB->uxMutexesHeld );
             ( pxTCB->uxMutexesHeld )--;
-
-            /* Has the holder of the mutex inherited the priority of another
-             * task? */
-            if( pxTCB->uxPriority != pxTCB->uxBasePriority )
-            {
-                /* Only disinherit if no other mutexes are held. */
-                if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
-                {
-                    /* A task can only have an inherited priority if it holds
-                     * the mutex.  If the mutex is held by a task then it cannot be
-                     * given from an interrupt, and if a mutex is given by the
-                     * holding task then it must be the running state task.  Remove
-                     * the holding task from the ready list. */
-                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                    {
-                        portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* Disinherit the priority before adding the task into the
-                     * new  ready list. */
-                    traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
-                    pxTCB->uxPriority = pxTCB->uxBasePriority;
-
-                    /* Reset the event list item value.  It cannot be in use for
-                     * any other purpose if this task is running, and it must be
-                     * running to give back the mutex. */
-                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority );
-                    prvAddTaskToReadyList( pxTCB );
-                    #if ( configNUMBER_OF_CORES > 1 )
-                    {
-                        /* The priority of the task is dropped. Yield the core on
-                         * which the task is running. */
-                        if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
-                        {
-                            prvYieldCore( pxTCB->xTaskRunState );
-                        }
-                    }
-                    #endif /* if ( configNUMBER_OF_CORES > 1 ) */
-
-                    /* Return true to indicate that a context switch is required.
-                     * This is only actually required in the corner case whereby
-                     * multiple mutexes were held and the mutexes were given back
-                     * in an order different to that in which they were taken.
-                     * If a context switch did not occur when the first mutex was
-                     * returned, even if a task was waiting on it, then a context
-                     * switch should occur when the last mutex is returned whether
-                     * a task is waiting on it or not. */
-                    xReturn = pdTRUE;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_xTaskPriorityDisinherit( xReturn );
+        /* No deadline was inherited.  Whether the task has to be preempted now
+         * is down to the system ceiling, see xTaskRestoreSystemCeiling(). */
+        traceRETURN_xTaskPriorityDisinherit( pdFALSE );
 
-        return xReturn;
+        return pdFALSE;
     }
 
 #endif /* configUSE_MUTEXES */
@@ -6652,116 +8400,82 @@ static void prvResetNextTaskUnblockTime( void )
     void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
                                               UBaseType_t uxHighestPriorityWaitingTask )
     {
-        TCB_t * const pxTCB = pxMutexHolder;
-        UBaseType_t uxPriorityUsedOnEntry, uxPriorityToUse;
-        const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
-
         traceENTER_vTaskPriorityDisinheritAfterTimeout( pxMutexHolder, uxHighestPriorityWaitingTask );
 
-        if( pxMutexHolder != NULL )
+        /* xTaskPriorityInherit() never reports inheritance, so there is
+         * nothing to undo. */
+        ( void ) pxMutexHolder;
+        ( void ) uxHighestPriorityWaitingTask;
+
+        traceRETURN_vTaskPriorityDisinheritAfterTimeout();
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    TickType_t xTaskRaiseSystemCeiling( TickType_t xCeiling )
+    {
+        TickType_t xPreviousCeiling;
+
+        traceENTER_xTaskRaiseSystemCeiling( xCeiling );
+
+        /* Called from a critical section as the calling task takes a mutex.
+         * Ceilings are relative deadlines, so the higher ceiling is the smaller
+         * value.  Raising the ceiling never makes the calling task yield, it is
+         * already running. */
+        xPreviousCeiling = xSystemCeiling;
+
+        if( xCeiling < xSystemCeiling )
         {
-            /* If pxMutexHolder is not NULL then the holder must hold at least
-             * one mutex. */
-            configASSERT( pxTCB->uxMutexesHeld );
+            xSystemCeiling = xCeiling;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            /* Determine the priority to which the priority of the task that
-             * holds the mutex should be set.  This will be the greater of the
-             * holding task's base priority and the priority of the highest
-             * priority task that is waiting to obtain the mutex. */
-            if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
-            {
-                uxPriorityToUse = uxHighestPriorityWaitingTask;
-            }
-            else
-            {
-                uxPriorityToUse = pxTCB->uxBasePriority;
-            }
+        traceRETURN_xTaskRaiseSystemCeiling( xPreviousCeiling );
 
-            /* Does the priority need to change? */
-            if( pxTCB->uxPriority != uxPriorityToUse )
-            {
-                /* Only disinherit if no other mutexes are held.  This is a
-                 * simplification in the priority inheritance implementation.  If
-                 * the task that holds the mutex is also holding other mutexes then
-                 * the other mutexes may have caused the priority inheritance. */
-                if( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
-                {
-                    /* If a task has timed out because it already holds the
-                     * mutex it was trying to obtain then it cannot of inherited
-                     * its own priority. */
-                    configASSERT( pxTCB != pxCurrentTCB );
+        return xPreviousCeiling;
+    }
 
-                    /* Disinherit the priority, remembering the previous
-                     * priority to facilitate determining the subject task's
-                     * state. */
-                    traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
-                    uxPriorityUsedOnEntry = pxTCB->uxPriority;
-                    pxTCB->uxPriority = uxPriorityToUse;
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
 
-                    /* Only reset the event list item value if the value is not
-                     * being used for anything else. */
-                    if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == ( ( TickType_t ) 0U ) )
-                    {
-                        listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+#if ( configUSE_MUTEXES == 1 )
 
-                    /* If the running task is not the task that holds the mutex
-                     * then the task that holds the mutex could be in either the
-                     * Ready, Blocked or Suspended states.  Only remove the task
-                     * from its current state list if it is in the Ready state as
-                     * the task's priority is going to change and there is one
-                     * Ready list per priority. */
-                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
-                    {
-                        if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                        {
-                            /* It is known that the task is in its ready list so
-                             * there is no need to check again and the port level
-                             * reset macro can be called directly. */
-                            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+    BaseType_t xTaskRestoreSystemCeiling( TickType_t xPreviousCeiling )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xReturn = pdFALSE;
 
-                        prvAddTaskToReadyList( pxTCB );
-                        #if ( configNUMBER_OF_CORES > 1 )
-                        {
-                            /* The priority of the task is dropped. Yield the core on
-                             * which the task is running. */
-                            if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
-                            {
-                                prvYieldCore( pxTCB->xTaskRunState );
-                            }
-                        }
-                        #endif /* if ( configNUMBER_OF_CORES > 1 ) */
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+        traceENTER_xTaskRestoreSystemCeiling( xPreviousCeiling );
+
+        /* Called from a critical section as the calling task gives a mutex.
+         * Mutexes have to be given in the reverse order to the one they were
+         * taken in, so the ceiling restored is never above the one in force. */
+        configASSERT( xPreviousCeiling >= xSystemCeiling );
+        xSystemCeiling = xPreviousCeiling;
+
+        /* Lowering the ceiling can let a task with an earlier deadline than
+         * the calling task start. */
+        pxTCB = taskGET_EARLIEST_DEADLINE_TASK( 0U );
+        taskAPPLY_SYSTEM_CEILING( pxTCB );
+
+        if( ( pxTCB != NULL ) && ( taskDEADLINE_IS_EARLIER( pxTCB, pxCurrentTCB ) != pdFALSE ) )
+        {
+            xReturn = pdTRUE;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        traceRETURN_vTaskPriorityDisinheritAfterTimeout();
+        traceRETURN_xTaskRestoreSystemCeiling( xReturn );
+
+        return xReturn;
     }
 
 #endif /* configUSE_MUTEXES */
@@ -7469,7 +9183,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
     /* Reset the event list item to its normal value - so it can be used with
      * queues and semaphores. */
-    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ) );
+    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( TickType_t ) 0U );
 
     traceRETURN_uxTaskResetEventItemValue( uxReturn );
 
@@ -7798,6 +9512,7 @@ TickType_t uxTaskResetEventItemValue( void )
             if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
             {
                 listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                taskRELEASE_JOB( pxTCB );
                 prvAddTaskToReadyList( pxTCB );
 
                 /* The task should not have been on an event list. */
@@ -7942,6 +9657,8 @@ TickType_t uxTaskResetEventItemValue( void )
                 /* The task should not have been on an event list. */
                 configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
 
+                taskRELEASE_JOB( pxTCB );
+
                 if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
                 {
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
@@ -7972,7 +9689,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
                 #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    if( taskPREEMPTS_CURRENT_TASK( pxTCB ) != pdFALSE )
                     {
                         /* The notified task has a priority above the currently
                          * executing task so a yield is required. */
@@ -8076,6 +9793,8 @@ TickType_t uxTaskResetEventItemValue( void )
                 /* The task should not have been on an event list. */
                 configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
 
+                taskRELEASE_JOB( pxTCB );
+
                 if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
                 {
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
@@ -8106,7 +9825,7 @@ TickType_t uxTaskResetEventItemValue( void )
 
                 #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    if( taskPREEMPTS_CURRENT_TASK( pxTCB ) != pdFALSE )
                     {
                         /* The notified task has a priority above the currently
                          * executing task so a yield is required. */
@@ -8411,6 +10130,8 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
     /* Remove the task from the ready list before adding it to the blocked list
      * as the same list item is used for both lists. */
+    taskREMOVE_FROM_READY_QUEUE( pxCurrentTCB );
+
     if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
     {
         /* The current task must be in a ready list, so there is no need to
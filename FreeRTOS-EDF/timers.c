@@ -261,7 +261,7 @@
                                                                      configTIMER_SERVICE_TASK_NAME,
                                                                      uxTimerTaskStackSize,
                                                                      NULL,
-                                                                     ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+                                                                     ( ( UBaseType_t ) configTIMER_TASK_DEADLINE ) | portPRIVILEGE_BIT,
                                                                      pxTimerTaskStackBuffer,
                                                                      pxTimerTaskTCBBuffer,
                                                                      configTIMER_SERVICE_TASK_CORE_AFFINITY );
@@ -277,7 +277,7 @@
                                                       configTIMER_SERVICE_TASK_NAME,
                                                       configTIMER_TASK_STACK_DEPTH,
                                                       NULL,
-                                                      ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+                                                      ( ( UBaseType_t ) configTIMER_TASK_DEADLINE ) | portPRIVILEGE_BIT,
                                                       configTIMER_SERVICE_TASK_CORE_AFFINITY,
                                                       &xTimerTaskHandle );
                 }
@@ -296,7 +296,7 @@
                                                           configTIMER_SERVICE_TASK_NAME,
                                                           uxTimerTaskStackSize,
                                                           NULL,
-                                                          ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+                                                          ( ( UBaseType_t ) configTIMER_TASK_DEADLINE ) | portPRIVILEGE_BIT,
                                                           pxTimerTaskStackBuffer,
                                                           pxTimerTaskTCBBuffer );
 
@@ -311,12 +311,50 @@
                                            configTIMER_SERVICE_TASK_NAME,
                                            configTIMER_TASK_STACK_DEPTH,
                                            NULL,
-                                           ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+                                           ( ( UBaseType_t ) configTIMER_TASK_DEADLINE ) | portPRIVILEGE_BIT,
                                            &xTimerTaskHandle );
                 }
                 #endif /* configSUPPORT_STATIC_ALLOCATION */
             }
             #endif /* #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) ) */
+
+            #if ( configTIMER_TASK_SERVER_BUDGET > 0 )
+            {
+                if( xReturn != pdFAIL )
+                {
+                    TaskServerHandle_t xTimerServer;
+
+                    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                    {
+                        PRIVILEGED_DATA static StaticTaskServer_t xStaticTimerServer;
+
+                        xTimerServer = xTaskCreateServerStatic( ( TickType_t ) configTIMER_TASK_SERVER_BUDGET,
+                                                                ( TickType_t ) configTIMER_TASK_SERVER_PERIOD,
+                                                                &xStaticTimerServer );
+                    }
+                    #else
+                    {
+                        xTimerServer = xTaskCreateServer( ( TickType_t ) configTIMER_TASK_SERVER_BUDGET,
+                                                          ( TickType_t ) configTIMER_TASK_SERVER_PERIOD );
+                    }
+                    #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+                    if( xTimerServer != NULL )
+                    {
+                        vTaskSetServer( xTimerTaskHandle, xTimerServer );
+                    }
+                    else
+                    {
+                        /* The server was not admitted. */
+                        xReturn = pdFAIL;
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configTIMER_TASK_SERVER_BUDGET */
         }
         else
         {
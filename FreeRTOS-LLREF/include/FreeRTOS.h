@@ -54,6 +54,10 @@
 #define TICK_TYPE_WIDTH_32_BITS    1
 #define TICK_TYPE_WIDTH_64_BITS    2
 
+/* Acceptable values for configADMISSION_CONTROL. */
+#define ADMISSION_CONTROL_FLAG      0
+#define ADMISSION_CONTROL_REJECT    1
+
 /* Application specific configuration options. */
 #include "FreeRTOSConfig.h"
 
@@ -513,12 +517,90 @@
     #define configUSE_PASSIVE_IDLE_HOOK    0
 #endif /* configUSE_PASSIVE_IDLE_HOOK */
 
+/* Periodic tasks are admitted while the sum of their utilizations stays within
+ * the number of cores.  A task that does not fit is passed to
+ * traceTASK_ADMISSION_FAILED().  With ADMISSION_CONTROL_FLAG it is still
+ * created, with ADMISSION_CONTROL_REJECT it is not. */
+#ifndef configADMISSION_CONTROL
+    #define configADMISSION_CONTROL    ADMISSION_CONTROL_FLAG
+#endif
+
+#if ( ( configADMISSION_CONTROL != ADMISSION_CONTROL_FLAG ) && ( configADMISSION_CONTROL != ADMISSION_CONTROL_REJECT ) )
+    #error configADMISSION_CONTROL must be ADMISSION_CONTROL_FLAG or ADMISSION_CONTROL_REJECT
+#endif
+
+/* Set configLLREF_MINIMISE_MIGRATIONS to 1 to keep tasks on the core they
+ * last ran on where LLREF does not mind which task runs.  A core choosing its
+ * next task takes one that last ran on it over the first waiting task when
+ * their places in the ready order are no more than
+ * configLLREF_MIGRATION_EPSILON ticks of local remaining (or, for tasks that
+ * are not periodic, remaining) execution apart.  When an event needs cores
+ * to be given up, a waiting task gets back the core it last ran on if it
+ * can. */
+#ifndef configLLREF_MINIMISE_MIGRATIONS
+    #define configLLREF_MINIMISE_MIGRATIONS    0
+#endif
+
+#ifndef configLLREF_MIGRATION_EPSILON
+    #define configLLREF_MIGRATION_EPSILON    1
+#endif
+
+#if ( configLLREF_MINIMISE_MIGRATIONS == 1 ) && ( configNUMBER_OF_CORES == 1 )
+    #error configLLREF_MINIMISE_MIGRATIONS can only be used with more than one core
+#endif
+
+/* Set configLLREF_CYCLE_ACCOUNTING to 1 to charge tasks for the time they
+ * actually ran rather than for the ticks that passed while they ran, so a task
+ * preempted part way through a tick is charged only for that part.  The port
+ * or application then supplies portLLREF_GET_CYCLE_COUNT(), a free running
+ * count of configLLREF_CYCLE_COUNT_TYPE that must be the same on every core,
+ * and configLLREF_CYCLES_PER_TICK, how far it counts in one tick.  That has to
+ * fit in a uint32_t. */
+/* Set configLLREF_DP_FAIR to 1 to schedule each TL-plane with the DP-Fair
+ * rules rather than LLREF's.  The planes and the shares of them are the same,
+ * but inside a plane a task runs until it has used up its share, tasks being
+ * taken in a fixed order, and is only preempted by a task whose share has
+ * grown to the rest of the plane.  That gives far fewer preemptions and
+ * migrations than always running the tasks with the most share left. */
+#ifndef configLLREF_DP_FAIR
+    #define configLLREF_DP_FAIR    0
+#endif
+
+#if ( configLLREF_DP_FAIR == 1 ) && ( configLLREF_MINIMISE_MIGRATIONS == 1 )
+    #error configLLREF_MINIMISE_MIGRATIONS cannot be used with configLLREF_DP_FAIR, the DP-Fair order already keeps tasks where they are
+#endif
+
+#ifndef configLLREF_CYCLE_ACCOUNTING
+    #define configLLREF_CYCLE_ACCOUNTING    0
+#endif
+
+#if ( configLLREF_CYCLE_ACCOUNTING == 1 )
+    #ifndef portLLREF_GET_CYCLE_COUNT
+        #error configLLREF_CYCLE_ACCOUNTING is 1 but portLLREF_GET_CYCLE_COUNT() is not defined
+    #endif
+
+    #ifndef configLLREF_CYCLES_PER_TICK
+        #error configLLREF_CYCLE_ACCOUNTING is 1 but configLLREF_CYCLES_PER_TICK is not defined
+    #endif
+
+    #ifndef configLLREF_CYCLE_COUNT_TYPE
+        #define configLLREF_CYCLE_COUNT_TYPE    uint64_t
+    #endif
+#endif
+
 /* The timers module relies on xTaskGetSchedulerState(). */
 #if configUSE_TIMERS == 1
 
-    #ifndef configTIMER_TASK_PRIORITY
-        #error If configUSE_TIMERS is set to 1 then configTIMER_TASK_PRIORITY must also be defined.
-    #endif /* configTIMER_TASK_PRIORITY */
+/* The timer service task has no priority under LLREF.  It is not periodic, so
+ * it only runs in the time the periodic tasks leave, and a burst of timer
+ * callbacks cannot take any of their share.  configTIMER_TASK_EXECUTION_TIME
+ * is the execution time it is created with.  The tasks that are not periodic
+ * run most remaining execution time first, and one that has used all of it
+ * only runs when nothing else can, so by default the timer service task never
+ * runs out and comes before every other task that is not periodic. */
+    #ifndef configTIMER_TASK_EXECUTION_TIME
+        #define configTIMER_TASK_EXECUTION_TIME    portMAX_DELAY
+    #endif /* configTIMER_TASK_EXECUTION_TIME */
 
     #ifndef configTIMER_QUEUE_LENGTH
         #error If configUSE_TIMERS is set to 1 then configTIMER_QUEUE_LENGTH must also be defined.
@@ -833,6 +915,18 @@
     #define traceTASK_CREATE_FAILED()
 #endif
 
+#ifndef traceTASK_ADMISSION_FAILED
+    #define traceTASK_ADMISSION_FAILED( pxNewTCB )
+#endif
+
+#ifndef traceTL_PLANE_START
+    #define traceTL_PLANE_START( xStart, xEnd )
+#endif
+
+#ifndef traceTASK_MIGRATED
+    #define traceTASK_MIGRATED( pxTCB, xFromCoreID, xToCoreID )
+#endif
+
 #ifndef traceTASK_DELETE
     #define traceTASK_DELETE( pxTaskToDelete )
 #endif
@@ -1693,6 +1787,14 @@
     #define traceRETURN_xTaskCreateStatic( xReturn )
 #endif
 
+#ifndef traceENTER_xTaskCreatePeriodicStatic
+    #define traceENTER_xTaskCreatePeriodicStatic( pxTaskCode, pcName, uxStackDepth, pvParameters, xPeriod, xWorstCaseExecutionTime, puxStackBuffer, pxTaskBuffer )
+#endif
+
+#ifndef traceRETURN_xTaskCreatePeriodicStatic
+    #define traceRETURN_xTaskCreatePeriodicStatic( xReturn )
+#endif
+
 #ifndef traceENTER_xTaskCreateStaticAffinitySet
     #define traceENTER_xTaskCreateStaticAffinitySet( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, puxStackBuffer, pxTaskBuffer, uxCoreAffinityMask )
 #endif
@@ -1741,6 +1843,14 @@
     #define traceRETURN_xTaskCreate( xReturn )
 #endif
 
+#ifndef traceENTER_xTaskCreatePeriodic
+    #define traceENTER_xTaskCreatePeriodic( pxTaskCode, pcName, uxStackDepth, pvParameters, xPeriod, xWorstCaseExecutionTime, pxCreatedTask )
+#endif
+
+#ifndef traceRETURN_xTaskCreatePeriodic
+    #define traceRETURN_xTaskCreatePeriodic( xReturn )
+#endif
+
 #ifndef traceENTER_xTaskCreateAffinitySet
     #define traceENTER_xTaskCreateAffinitySet( pxTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, uxCoreAffinityMask, pxCreatedTask )
 #endif
@@ -1773,6 +1883,30 @@
     #define traceRETURN_vTaskDelay()
 #endif
 
+#ifndef traceENTER_vTaskWaitForNextPeriod
+    #define traceENTER_vTaskWaitForNextPeriod()
+#endif
+
+#ifndef traceRETURN_vTaskWaitForNextPeriod
+    #define traceRETURN_vTaskWaitForNextPeriod()
+#endif
+
+#ifndef traceENTER_lTaskGetAdmissionHeadroom
+    #define traceENTER_lTaskGetAdmissionHeadroom( xCoreID )
+#endif
+
+#ifndef traceRETURN_lTaskGetAdmissionHeadroom
+    #define traceRETURN_lTaskGetAdmissionHeadroom( lHeadroom )
+#endif
+
+#ifndef traceENTER_uxTaskGetMigrationCount
+    #define traceENTER_uxTaskGetMigrationCount( xTask )
+#endif
+
+#ifndef traceRETURN_uxTaskGetMigrationCount
+    #define traceRETURN_uxTaskGetMigrationCount( uxReturn )
+#endif
+
 #ifndef traceENTER_eTaskGetState
     #define traceENTER_eTaskGetState( xTask )
 #endif
@@ -3221,6 +3355,19 @@ typedef struct xSTATIC_TCB
         int iDummy22;
     #endif
     TickType_t uxDummy27;
+    TickType_t xDummy28[ 3 ];
+    uint32_t ulDummy29[ 2 ];
+    TickType_t xDummy30;
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xDummy31;
+        UBaseType_t uxDummy32;
+    #endif
+    #if ( configLLREF_CYCLE_ACCOUNTING == 1 )
+        uint32_t ulDummy33;
+    #endif
+    #if ( configLLREF_DP_FAIR == 1 )
+        TickType_t xDummy34;
+    #endif
 } StaticTask_t;
 
 /*
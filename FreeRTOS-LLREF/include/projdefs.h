@@ -65,6 +65,7 @@ typedef void (* TaskFunction_t)( void * arg );
 #define errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY    ( -1 )
 #define errQUEUE_BLOCKED                         ( -4 )
 #define errQUEUE_YIELD                           ( -5 )
+#define errTASK_NOT_ADMITTED                     ( -6 )
 
 /* Macros used for basic data corruption checks. */
 #ifndef configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES
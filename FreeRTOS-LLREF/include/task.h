@@ -205,6 +205,14 @@ typedef enum
  */
 #define tskNO_AFFINITY      ( ( UBaseType_t ) -1 )
 
+/**
+ * The utilization of a task that needs the whole of a core, see
+ * lTaskGetAdmissionHeadroom().
+ *
+ * \ingroup TaskUtils
+ */
+#define tskUTILIZATION_ONE    ( ( int32_t ) 10000 )
+
 /**
  * task. h
  *
@@ -518,6 +526,72 @@ typedef enum
                                     StaticTask_t * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskCreatePeriodic(
+ *                            TaskFunction_t pxTaskCode,
+ *                            const char * const pcName,
+ *                            const configSTACK_DEPTH_TYPE uxStackDepth,
+ *                            void *pvParameters,
+ *                            TickType_t xPeriod,
+ *                            TickType_t xWorstCaseExecutionTime,
+ *                            TaskHandle_t *pxCreatedTask
+ *                        );
+ *
+ * TaskHandle_t xTaskCreatePeriodicStatic(
+ *                            TaskFunction_t pxTaskCode,
+ *                            const char * const pcName,
+ *                            const configSTACK_DEPTH_TYPE uxStackDepth,
+ *                            void *pvParameters,
+ *                            TickType_t xPeriod,
+ *                            TickType_t xWorstCaseExecutionTime,
+ *                            StackType_t * const puxStackBuffer,
+ *                            StaticTask_t * const pxTaskBuffer
+ *                        );
+ * @endcode
+ *
+ * Create a periodic task.  Each job of the task starts with
+ * xWorstCaseExecutionTime ticks of remaining execution time, and has to finish
+ * before the next job is released.
+ *
+ * The first job is released when the task is created.  Each following job is
+ * released xPeriod ticks after the one before it, when the task calls
+ * vTaskWaitForNextPeriod().
+ *
+ * The task is passed to admission control, see configADMISSION_CONTROL and
+ * lTaskGetAdmissionHeadroom().  If it is rejected xTaskCreatePeriodic() returns
+ * errTASK_NOT_ADMITTED, and xTaskCreatePeriodicStatic() returns NULL.
+ *
+ * @param xPeriod The time between releases in ticks.  Must be greater than 0.
+ *
+ * @param xWorstCaseExecutionTime The worst case execution time of each job in
+ * ticks.  Must be greater than 0.
+ *
+ * \defgroup xTaskCreatePeriodic xTaskCreatePeriodic
+ * \ingroup Tasks
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    BaseType_t xTaskCreatePeriodic( TaskFunction_t pxTaskCode,
+                                    const char * const pcName,
+                                    const configSTACK_DEPTH_TYPE uxStackDepth,
+                                    void * const pvParameters,
+                                    TickType_t xPeriod,
+                                    TickType_t xWorstCaseExecutionTime,
+                                    TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    TaskHandle_t xTaskCreatePeriodicStatic( TaskFunction_t pxTaskCode,
+                                            const char * const pcName,
+                                            const configSTACK_DEPTH_TYPE uxStackDepth,
+                                            void * const pvParameters,
+                                            TickType_t xPeriod,
+                                            TickType_t xWorstCaseExecutionTime,
+                                            StackType_t * const puxStackBuffer,
+                                            StaticTask_t * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
     TaskHandle_t xTaskCreateStaticAffinitySet( TaskFunction_t pxTaskCode,
                                                const char * const pcName,
@@ -935,6 +1009,70 @@ BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
         ( void ) xTaskDelayUntil( ( pxPreviousWakeTime ), ( xTimeIncrement ) ); \
     } while( 0 )
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskWaitForNextPeriod( void );
+ * @endcode
+ *
+ * Ends the current job of a task created with xTaskCreatePeriodic() or
+ * xTaskCreatePeriodicStatic(), and blocks the task until its next job is
+ * released.  The next release is one period after the last one, so it does not
+ * drift with how long the job took.  The next job starts with the whole of its
+ * worst case execution time remaining.
+ *
+ * If the job overran its period the next job has already been released, and
+ * the task carries on without blocking.
+ *
+ * \defgroup vTaskWaitForNextPeriod vTaskWaitForNextPeriod
+ * \ingroup TaskCtrl
+ */
+void vTaskWaitForNextPeriod( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * int32_t lTaskGetAdmissionHeadroom( BaseType_t xCoreID );
+ * @endcode
+ *
+ * Returns how much more utilization the scheduler can admit, in units where
+ * tskUTILIZATION_ONE is the whole of one core.  A periodic task has a
+ * utilization of its worst case execution time over its period, and is
+ * admitted if that is no more than the headroom and no more than one core.
+ *
+ * The result is negative if tasks have been created past the bound with
+ * configADMISSION_CONTROL set to ADMISSION_CONTROL_FLAG.
+ *
+ * @param xCoreID Not used, LLREF shares all of the cores between all of the
+ * tasks.  It is kept so the call is the same as on the EDF scheduler.
+ *
+ * \defgroup lTaskGetAdmissionHeadroom lTaskGetAdmissionHeadroom
+ * \ingroup TaskCtrl
+ */
+int32_t lTaskGetAdmissionHeadroom( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetMigrationCount( TaskHandle_t xTask );
+ * @endcode
+ *
+ * Returns how many times a task has been switched in on a different core to
+ * the one it last ran on.  Migrations are counted whether or not
+ * configLLREF_MINIMISE_MIGRATIONS is set, so the two can be compared.
+ *
+ * Only available when configNUMBER_OF_CORES is greater than 1.
+ *
+ * @param xTask Handle of the task to query.  Passing NULL queries the calling
+ * task.
+ *
+ * \defgroup uxTaskGetMigrationCount uxTaskGetMigrationCount
+ * \ingroup TaskCtrl
+ */
+#if ( configNUMBER_OF_CORES > 1 )
+    UBaseType_t uxTaskGetMigrationCount( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 
 /**
  * task. h
@@ -3634,8 +3772,17 @@ BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder ) PRIVILEGED_F
  */
 BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
 
+/*
+ * The execution time a task has left, in ticks rounded up.  With
+ * configLLREF_CYCLE_ACCOUNTING pubGetxRemainingExecutionCycles() gives it
+ * exactly, in counts of portLLREF_GET_CYCLE_COUNT().
+ */
 TickType_t pubGetxRemainingExecutionTime(TaskHandle_t);
 
+#if ( configLLREF_CYCLE_ACCOUNTING == 1 )
+    configLLREF_CYCLE_COUNT_TYPE pubGetxRemainingExecutionCycles(TaskHandle_t);
+#endif
+
 /*
  * If a higher priority task attempting to obtain a mutex caused a lower
  * priority task to inherit the higher priority task's priority - but the higher
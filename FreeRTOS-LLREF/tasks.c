@@ -125,6 +125,73 @@
  */
 #define tskSTACK_FILL_BYTE                        ( 0xa5U )
 
+/* Utilization is held in fixed point, a task with a utilization of
+ * taskUTILIZATION_ONE needs the whole of a core. */
+#define taskUTILIZATION_ONE                       ( ( uint32_t ) tskUTILIZATION_ONE )
+#define taskUTILIZATION_MAX                       ( taskUTILIZATION_ONE * 100U )
+
+/* LLREF can schedule any set of periodic tasks with implicit deadlines whose
+ * total utilization is no more than the number of cores, as long as no task
+ * needs more than one core. */
+#define taskADMISSION_BOUND                       ( taskUTILIZATION_ONE * ( uint32_t ) configNUMBER_OF_CORES )
+
+/* Local remaining execution is held in the same fixed point, with
+ * taskUTILIZATION_ONE standing for one tick.  A TL-plane is cut short when it
+ * would be so long that a share of it no longer fits in half a TickType_t. */
+#define taskLLREF_MAX_PLANE_LENGTH                ( ( TickType_t ) ( ( portMAX_DELAY >> 1 ) / taskUTILIZATION_ONE ) )
+
+#define taskIS_PERIODIC( pxTCB )                  ( ( pxTCB )->xPeriod != ( TickType_t ) 0U )
+
+/* The item value a task is kept at in the LLREF ready buckets.  Periodic tasks
+ * with some of their share of the plane left come first, the most left first.
+ * Then come the periodic tasks that have used up their share, which still have
+ * to finish their jobs and so run in any time the plane has spare before the
+ * tasks that are not periodic.  Those come last, the most remaining execution
+ * time first.  With configLLREF_DP_FAIR the periodic tasks with share left are
+ * in their xSliceOrder instead. */
+#if ( configLLREF_DP_FAIR == 1 )
+    #define taskLLREF_PERIODIC_KEY( pxTCB )    ( ( pxTCB )->xSliceOrder )
+#else
+    #define taskLLREF_PERIODIC_KEY( pxTCB )    ( ( TickType_t ) ( portMAX_DELAY >> 1 ) - ( TickType_t ) ( pxTCB )->ulLocalRemainingExecution )
+#endif
+
+#define taskLLREF_SHARE_USED                      ( ( TickType_t ) ( portMAX_DELAY >> 1 ) )
+
+#define taskLLREF_ITEM_VALUE( pxTCB )                                                                            \
+    ( taskIS_PERIODIC( pxTCB ) ?                                                                                 \
+      ( ( ( pxTCB )->ulLocalRemainingExecution == 0U ) ? taskLLREF_SHARE_USED : taskLLREF_PERIODIC_KEY( pxTCB ) ) : \
+      ( ( portMAX_DELAY - ( TickType_t ) 1U ) -                                                                  \
+        ( ( ( pxTCB )->xRemainingExecutionTime < ( portMAX_DELAY >> 1 ) ) ?                                      \
+          ( pxTCB )->xRemainingExecutionTime : ( ( portMAX_DELAY >> 1 ) - ( TickType_t ) 1U ) ) ) )
+
+/* The ready tasks are split into buckets so that neither finding the best one
+ * nor finding the place for a new one means walking all of them.  Periodic
+ * tasks with some share left go in buckets 0 to 31, one for each power of two
+ * of their local remaining execution, the largest first.  The periodic tasks
+ * that have used up their share go at the end of bucket 31.  Tasks that are
+ * not periodic go in buckets 32 to 63 the same way by remaining execution
+ * time, the last bucket also holding those that have nothing left.  Inside a
+ * bucket tasks are sorted by taskLLREF_ITEM_VALUE(), so the buckets taken in
+ * turn give exactly the order above.  A bit is set in ulReadyBucketsMapLLREF
+ * for each bucket that may have tasks in it, bucket 0 being the most
+ * significant bit of the first word. */
+#define taskLLREF_BUCKETS                         ( 64U )
+#define taskLLREF_BUCKET_WORDS                    ( taskLLREF_BUCKETS / 32U )
+#define taskLLREF_BUCKET_BIT( uxBucket )          ( ( uint32_t ) 0x80000000UL >> ( ( uxBucket ) & 31U ) )
+#define taskLLREF_SHARE_USED_BUCKET               ( 31U )
+
+#define taskLLREF_IS_READY( pxTCB )                                                               \
+    ( ( listLIST_ITEM_CONTAINER( &( ( pxTCB )->xStateListItem ) ) >= &( xReadyBucketsLLREF[ 0 ] ) ) && \
+      ( listLIST_ITEM_CONTAINER( &( ( pxTCB )->xStateListItem ) ) <= &( xReadyBucketsLLREF[ taskLLREF_BUCKETS - 1U ] ) ) )
+
+/* The index of the most significant bit set in a word that is not 0.  GCC
+ * turns this into a single CLZ instruction on the cores that have one. */
+#if defined( __GNUC__ )
+    #define taskLLREF_LOG2( ulValue )             ( ( UBaseType_t ) ( 31 - __builtin_clz( ( unsigned int ) ( ulValue ) ) ) )
+#else
+    #define taskLLREF_LOG2( ulValue )             prvLLREFLog2( ulValue )
+#endif
+
 /* Bits used to record how a task's stack and TCB were allocated. */
 #define tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB    ( ( uint8_t ) 0 )
 #define tskSTATICALLY_ALLOCATED_STACK_ONLY        ( ( uint8_t ) 1 )
@@ -261,18 +328,21 @@
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  A periodic task is first given its share of what is left of the
+ * TL-plane.  One whose job has no execution time left still has to finish the
+ * job, so it stays in the ready buckets rather than waiting with the idle
+ * tasks.
  */
 #define prvAddTaskToReadyList( pxTCB )                                                                     \
     do {                                                                                                   \
         traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
-        if( ( pxTCB )->xRemainingExecutionTime == 0)                                                       \
+        if( taskIS_PERIODIC( pxTCB ) )                                                                     \
+        { prvLLREFTaskReady( pxTCB ); }                                                                    \
+        if( ( ( pxTCB )->xRemainingExecutionTime == 0U ) && !taskIS_PERIODIC( pxTCB ) )                    \
         { listINSERT_END( &xReadyIdleTasks, &( ( pxTCB )->xStateListItem ) ); }                            \
         else                                                                                               \
         {                                                                                                  \
-            listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ),                                       \
-                                 ( ( TickType_t )-1 ) - ( pxTCB )->xRemainingExecutionTime );              \
-            vListInsert( &( xReadyTaskListLLREF ), &( ( pxTCB )->xStateListItem ) );                       \
+            prvLLREFInsert( pxTCB );                                                                       \
         }                                                                                                  \
         tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
     } while( 0 )
@@ -439,6 +509,22 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #endif
     
     TickType_t xRemainingExecutionTime;
+    TickType_t xReleaseTime;            /**< The tick the current job of a periodic task was released at. */
+    TickType_t xPeriod;                 /**< The time between releases of a periodic task in ticks, 0 if the task is not periodic. */
+    TickType_t xWorstCaseExecutionTime; /**< The execution time each job of a periodic task starts with. */
+    uint32_t ulUtilization;             /**< prvTaskUtilization() of a periodic task, kept so planes can be started without dividing. */
+    uint32_t ulLocalRemainingExecution; /**< What is left of the task's share of the current TL-plane, taskUTILIZATION_ONE is one tick. */
+    TickType_t xLocalPlaneEnd;          /**< The end of the plane ulLocalRemainingExecution was given for. */
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xLastCoreID;         /**< The core the task last ran on, -1 if it has not run yet. */
+        UBaseType_t uxMigrations;       /**< How many times the task has been switched in on a different core to the one it last ran on. */
+    #endif
+    #if ( configLLREF_CYCLE_ACCOUNTING == 1 )
+        uint32_t ulConsumedCycles;      /**< How much of the last tick of xRemainingExecutionTime has been used, in cycles. */
+    #endif
+    #if ( configLLREF_DP_FAIR == 1 )
+        TickType_t xSliceOrder;         /**< Where the task comes in the DP-Fair order of the plane, 0 once its share is the rest of the plane. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -462,7 +548,8 @@ typedef tskTCB TCB_t;
  * xDelayedTaskList1 and xDelayedTaskList2 could be moved to function scope but
  * doing so breaks some kernel aware debuggers and debuggers that rely on removing
  * the static qualifier. */
-PRIVILEGED_DATA static List_t xReadyTaskListLLREF;
+PRIVILEGED_DATA static List_t xReadyBucketsLLREF[ taskLLREF_BUCKETS ];
+PRIVILEGED_DATA static uint32_t ulReadyBucketsMapLLREF[ taskLLREF_BUCKET_WORDS ];
 PRIVILEGED_DATA static List_t xReadyIdleTasks;
 PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /**< Delayed tasks. */
 PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /**< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
@@ -470,7 +557,19 @@ PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /**< Po
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /**< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /**< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
-PRIVILEGED_DATA static TickType_t ulSwitchInTimeLLREF[ configNUMBER_OF_CORES ];
+PRIVILEGED_DATA static List_t xPlaneResortList;                          /**< Holds the periodic tasks while prvLLREFStartPlane() sorts them again. */
+
+PRIVILEGED_DATA static TickType_t xPlaneEndLLREF = ( TickType_t ) 0U;    /**< The tick the current TL-plane ends at. */
+PRIVILEGED_DATA static volatile BaseType_t xRescheduleLLREF = pdFALSE;  /**< Set when a plane starts or a periodic task arrives, so the next tick picks the tasks to run again. */
+PRIVILEGED_DATA static volatile TickType_t xNextEventLLREF = ( TickType_t ) 0U; /**< The tick the next B or C event or plane end is due at. */
+PRIVILEGED_DATA static TickType_t xChargedUntilLLREF[ configNUMBER_OF_CORES ]; /**< The tick the task running on each core has been charged up to. */
+#if ( configLLREF_DP_FAIR == 1 )
+    PRIVILEGED_DATA static TickType_t xNextSliceOrderLLREF = ( TickType_t ) 1U; /**< The xSliceOrder the next task given a share of the plane gets. */
+#endif
+#if ( configLLREF_CYCLE_ACCOUNTING == 1 )
+    PRIVILEGED_DATA static configLLREF_CYCLE_COUNT_TYPE xChargedCyclesLLREF[ configNUMBER_OF_CORES ]; /**< The cycle count the task running on each core has been charged up to. */
+#endif
+PRIVILEGED_DATA static uint32_t ulAdmittedUtilization = 0U; /**< Sum of the utilization of the periodic tasks, see prvTaskUtilization(). */
 
 #if configNUMBER_OF_CORES == 1
 static TCB_t *pxSelectLLREFTask(void);
@@ -543,34 +642,70 @@ PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime[ conf
  * Creates the idle tasks during scheduler start.
  */
 
-TickType_t pubGetxRemainingExecutionTime(TaskHandle_t handle) {
+#if ( configLLREF_CYCLE_ACCOUNTING == 1 )
+
+configLLREF_CYCLE_COUNT_TYPE pubGetxRemainingExecutionCycles(TaskHandle_t handle) {
     TCB_t* pxTCB = prvGetTCBFromHandle( handle );
-#if configNUMBER_OF_CORES == 1
+    const uint64_t ullRemaining = ( ( uint64_t ) pxTCB->xRemainingExecutionTime * ( uint64_t ) configLLREF_CYCLES_PER_TICK ) - pxTCB->ulConsumedCycles;
+    uint64_t ullElapsed = 0;
 
+    // A running task has not been charged since its core last handled an event
+#if configNUMBER_OF_CORES == 1
     if( pxTCB == pxCurrentTCB )
     {
-        // It is currently running, we must calculate the remaining time as it has not been updated
-        return pxTCB->xRemainingExecutionTime - ( xTickCount - ulSwitchInTimeLLREF[ 0 ] );
+        ullElapsed = ( uint64_t ) ( configLLREF_CYCLE_COUNT_TYPE ) ( portLLREF_GET_CYCLE_COUNT() - xChargedCyclesLLREF[ 0 ] );
     }
-    else
+#else
+    if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
+    {
+        ullElapsed = ( uint64_t ) ( configLLREF_CYCLE_COUNT_TYPE ) ( portLLREF_GET_CYCLE_COUNT() - xChargedCyclesLLREF[ pxTCB->xTaskRunState ] );
+    }
+#endif
+
+    if( ullRemaining > ullElapsed )
+    {
+        return ( configLLREF_CYCLE_COUNT_TYPE ) ( ullRemaining - ullElapsed );
+    }
+
+    return 0;
+}
+
+TickType_t pubGetxRemainingExecutionTime(TaskHandle_t handle) {
+    const uint64_t ullCyclesPerTick = ( uint64_t ) configLLREF_CYCLES_PER_TICK;
+
+    // Part of a tick left still counts as a tick
+    return ( TickType_t ) ( ( ( uint64_t ) pubGetxRemainingExecutionCycles( handle ) + ullCyclesPerTick - 1U ) / ullCyclesPerTick );
+}
+
+#else /* #if ( configLLREF_CYCLE_ACCOUNTING == 1 ) */
+
+TickType_t pubGetxRemainingExecutionTime(TaskHandle_t handle) {
+    TCB_t* pxTCB = prvGetTCBFromHandle( handle );
+    TickType_t xElapsed = 0;
+
+    // A running task has not been charged since its core last handled an event
+#if configNUMBER_OF_CORES == 1
+    if( pxTCB == pxCurrentTCB )
     {
-        // We can used the saved time
-        return pxTCB->xRemainingExecutionTime;
+        xElapsed = xTickCount - xChargedUntilLLREF[ 0 ];
     }
 #else
     if( taskTASK_IS_RUNNING( pxTCB ) == pdTRUE )
     {
-        // We need to calculate it's remaining time
-        return pxTCB->xRemainingExecutionTime - ( xTickCount - ulSwitchInTimeLLREF[ pxTCB->xTaskRunState ] );
+        xElapsed = xTickCount - xChargedUntilLLREF[ pxTCB->xTaskRunState ];
     }
-    else
+#endif
+
+    if( pxTCB->xRemainingExecutionTime > xElapsed )
     {
-        // Not running use saved time
-        return pxTCB->xRemainingExecutionTime;
+        return pxTCB->xRemainingExecutionTime - xElapsed;
     }
-#endif
+
+    return 0;
 }
 
+#endif /* #if ( configLLREF_CYCLE_ACCOUNTING == 1 ) */
+
 static BaseType_t prvCreateIdleTasks( void );
 
 #if ( configNUMBER_OF_CORES > 1 )
@@ -644,7 +779,7 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
  * This does not free memory allocated by the task itself (i.e. memory
  * allocated by calls to pvPortMalloc from within the tasks application code).
  */
-#if ( INCLUDE_vTaskDelete == 1 )
+#if ( ( INCLUDE_vTaskDelete == 1 ) || ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configADMISSION_CONTROL == ADMISSION_CONTROL_REJECT ) ) )
 
     static void prvDeleteTCB( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
 
@@ -752,7 +887,106 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
  * Called after a new task has been created and initialised to place the task
  * under the control of the scheduler.
  */
-static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
+static BaseType_t prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the share of a core a periodic task needs, where taskUTILIZATION_ONE
+ * is the whole core.  Tasks that are not periodic count as 0.
+ */
+static uint32_t prvTaskUtilization( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * LLREF splits time into TL-planes, each ending at the next deadline of a
+ * ready periodic task or the next time a task is unblocked.  At the start of a
+ * plane every ready periodic task is given its share of the plane, its
+ * utilization times the plane length, as local remaining execution.  The
+ * cores then run the tasks with the most local remaining execution, and only
+ * choose again when a running task uses up its share (a B event), when a
+ * waiting task has exactly as much share left as there is plane left (a C
+ * event), or when a task arrives.  The plane is no longer than xLength, the
+ * deadline of a task that is about to be made ready is not in the buckets yet.
+ */
+static void prvLLREFStartPlane( TickType_t xNow,
+                                TickType_t xLength ) PRIVILEGED_FUNCTION;
+static void prvLLREFTaskReady( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+static void prvLLREFCharge( BaseType_t xCoreID,
+                           TickType_t xNow ) PRIVILEGED_FUNCTION;
+static void prvLLREFChargeRunning( TickType_t xNow ) PRIVILEGED_FUNCTION;
+
+#if ( configLLREF_CYCLE_ACCOUNTING == 1 )
+
+/*
+ * With configLLREF_CYCLE_ACCOUNTING a task's remaining execution time is
+ * xRemainingExecutionTime rounded up to whole ticks, less ulConsumedCycles.
+ * prvLLREFRemainingCycles() returns it exactly and prvLLREFChargeCycles()
+ * takes time run from it and from the task's share of the plane.
+ */
+    static uint64_t prvLLREFRemainingCycles( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    static void prvLLREFChargeCycles( TCB_t * pxTCB,
+                                      uint64_t ullCycles ) PRIVILEGED_FUNCTION;
+#endif
+static void prvLLREFSetNextEvent( TickType_t xNow ) PRIVILEGED_FUNCTION;
+static void prvLLREFResort( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+static BaseType_t prvLLREFReschedule( void ) PRIVILEGED_FUNCTION;
+
+#if ( configLLREF_DP_FAIR == 1 )
+
+/*
+ * With configLLREF_DP_FAIR the periodic tasks with share left are run in the
+ * order they were given their share, which prvLLREFSliceOrder() records in
+ * xSliceOrder.  A task whose share has grown to the rest of the plane has no
+ * local laxity left and is given order 0, in front of the rest, which
+ * prvLLREFPromoteZeroLaxity() does at every event.
+ */
+    static void prvLLREFSliceOrder( TCB_t * pxTCB,
+                                    TickType_t xPlaneLeft ) PRIVILEGED_FUNCTION;
+    static void prvLLREFPromoteZeroLaxity( TickType_t xNow ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * The LLREF ready buckets.  prvLLREFInsert() sorts a task into its bucket.
+ * prvLLREFHead() returns the first ready task in LLREF order and
+ * prvLLREFNext() the one after a given task, both return NULL at the end.
+ * Removing a task from a bucket does not clear the bucket's bit, that is
+ * done by prvLLREFFirstBucket() when it finds the bucket empty.
+ */
+static UBaseType_t prvLLREFBucket( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+static void prvLLREFInsert( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+static UBaseType_t prvLLREFFirstBucket( UBaseType_t uxFrom ) PRIVILEGED_FUNCTION;
+static ListItem_t * prvLLREFHead( void ) PRIVILEGED_FUNCTION;
+static ListItem_t * prvLLREFNext( const ListItem_t * pxItem ) PRIVILEGED_FUNCTION;
+
+#if ( configLLREF_MINIMISE_MIGRATIONS == 1 )
+
+/*
+ * Returns pdTRUE if pxOther, which comes after pxFirst in the ready buckets,
+ * is close enough to pxFirst in LLREF order that a core may run it instead to
+ * save a migration.  See configLLREF_MIGRATION_EPSILON.
+ */
+    static BaseType_t prvLLREFNear( const TCB_t * pxFirst,
+                                    const TCB_t * pxOther ) PRIVILEGED_FUNCTION;
+#endif
+
+#if !defined( __GNUC__ )
+    static UBaseType_t prvLLREFLog2( uint32_t ulValue ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Nothing is done for LLREF on the ticks between events.  Running tasks are
+ * charged for the time they ran when they are switched out or an event is
+ * handled, and after every decision prvLLREFSetNextEvent() works out when the
+ * next event is due from the running tasks and the first waiting one.
+ */
+
+/*
+ * Admission control.  prvAdmitTask() adds the utilization of the task to the
+ * total.  If that goes over the LLREF bound it calls
+ * traceTASK_ADMISSION_FAILED(), and with ADMISSION_CONTROL_REJECT returns
+ * pdFAIL without admitting the task.  prvReleaseTask() takes the utilization
+ * off again.
+ */
+static BaseType_t prvAdmitTask( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+static void prvReleaseTask( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
 
 /*
  * Create a task with static buffer for both TCB and stack. Returns a handle to
@@ -1045,33 +1279,59 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
         /* This function should be called when scheduler is running. */
         configASSERT( xSchedulerRunning == pdTRUE );
 
-        const ListItem_t * pxEndMarker = listGET_END_MARKER( &xReadyTaskListLLREF );
+        const ListItem_t * pxEndMarker;
         ListItem_t * pxIterator;
 
-        for( pxIterator = listGET_HEAD_ENTRY( &xReadyTaskListLLREF ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+        /* The ready buckets are in LLREF order, so this core takes the first
+         * task that is not running on another core.  The task it is already
+         * running keeps the core if nothing ahead of it is waiting. */
+        for( pxIterator = prvLLREFHead(); pxIterator != NULL; pxIterator = prvLLREFNext( pxIterator ) )
         {
             pxTCB = ( TCB_t* )listGET_LIST_ITEM_OWNER( pxIterator );
 
-            if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
-            {
-                // The task is not currently on any core
-                if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
-                {
-                    // We're allowed to run it
-                    pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
-                    pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
-                    pxTCB->xTaskRunState = xCoreID;
-                    pxCurrentTCBs[ xCoreID ] = pxTCB;
-                    xTaskScheduled = pdTRUE;
-                }
-            }
-            else if( pxTCB == pxCurrentTCBs[ xCoreID ] )
+            if( ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) || ( pxTCB == pxCurrentTCBs[ xCoreID ] ) )
             {
-                // Task is already running so mark it as scheduled
                 if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
                 {
+                    #if ( configLLREF_MINIMISE_MIGRATIONS == 1 )
+                    {
+                        /* Look past the first task for one nearly as far
+                         * ahead that was already on this core. */
+                        if( ( pxTCB != pxCurrentTCBs[ xCoreID ] ) && ( pxTCB->xLastCoreID != xCoreID ) )
+                        {
+                            const ListItem_t * pxLater;
+
+                            for( pxLater = prvLLREFNext( pxIterator ); pxLater != NULL; pxLater = prvLLREFNext( pxLater ) )
+                            {
+                                TCB_t * const pxLaterTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxLater );
+
+                                if( prvLLREFNear( pxTCB, pxLaterTCB ) == pdFALSE )
+                                {
+                                    break;
+                                }
+
+                                if( ( ( pxLaterTCB->xTaskRunState == taskTASK_NOT_RUNNING ) || ( pxLaterTCB == pxCurrentTCBs[ xCoreID ] ) ) &&
+                                    ( ( pxLaterTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U ) &&
+                                    ( ( pxLaterTCB == pxCurrentTCBs[ xCoreID ] ) || ( pxLaterTCB->xLastCoreID == xCoreID ) ) )
+                                {
+                                    pxTCB = pxLaterTCB;
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                    #endif /* #if ( configLLREF_MINIMISE_MIGRATIONS == 1 ) */
+
+                    if( pxTCB != pxCurrentTCBs[ xCoreID ] )
+                    {
+                        pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
+                        pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+                        pxCurrentTCBs[ xCoreID ] = pxTCB;
+                    }
+
                     pxTCB->xTaskRunState = xCoreID;
                     xTaskScheduled = pdTRUE;
+                    break;
                 }
             }
         }
@@ -1085,26 +1345,20 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             {
                 pxTCB = ( TCB_t* )listGET_LIST_ITEM_OWNER( pxIterator );
 
-                if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
-                {
-                    // The task is not currently on any core
-                    if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
-                    {
-                        // We're allowed to run it
-                        pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
-                        pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
-                        pxTCB->xTaskRunState = xCoreID;
-                        pxCurrentTCBs[ xCoreID ] = pxTCB;
-                        xTaskScheduled = pdTRUE;
-                    }
-                }
-                else if( pxTCB == pxCurrentTCBs[ xCoreID ] )
+                if( ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) || ( pxTCB == pxCurrentTCBs[ xCoreID ] ) )
                 {
-                    // Task is already running so mark it as scheduled
                     if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U )
                     {
+                        if( pxTCB != pxCurrentTCBs[ xCoreID ] )
+                        {
+                            pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
+                            pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+                            pxCurrentTCBs[ xCoreID ] = pxTCB;
+                        }
+
                         pxTCB->xTaskRunState = xCoreID;
                         xTaskScheduled = pdTRUE;
+                        break;
                     }
                 }
             }
@@ -1114,30 +1368,38 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
         {
             if( xTaskScheduled == pdTRUE )
             {
-                if( ( pxPreviousTCB != NULL ) && ( listIS_CONTAINED_WITHIN( &xReadyTaskListLLREF, &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
+                if( ( pxPreviousTCB != NULL ) && ( taskLLREF_IS_READY( pxPreviousTCB ) ) )
                 {
                     /* A ready task was just evicted from this core. See if it can be
                      * scheduled on any other core. */
                     UBaseType_t uxCoreMap = pxPreviousTCB->uxCoreAffinityMask;
-                    TickType_t xLowestExecutionTime = pxPreviousTCB->xRemainingExecutionTime;
+                    TickType_t xLowestRank = listGET_LIST_ITEM_VALUE( &( pxPreviousTCB->xStateListItem ) );
                     BaseType_t xLowestExecutionTimeCore = -1;
                     BaseType_t x;
 
                     for( x = ( ( BaseType_t ) configNUMBER_OF_CORES - 1 ); x >= ( BaseType_t ) 0; x-- )
                     {
                         UBaseType_t uxCore = ( UBaseType_t ) x;
-                        TickType_t xExecutionTime;
+                        TickType_t xRank;
 
-                        if( uxCoreMap & ( ( UBaseType_t ) 1U << uxCore ) == 0 )
+                        if( ( uxCoreMap & ( ( UBaseType_t ) 1U << uxCore ) ) == 0U )
                             continue; // The task is not allowed to run on this core
 
-                        xExecutionTime = pxCurrentTCBs[ uxCore ]->xRemainingExecutionTime;
+                        // Tasks in the idle list come after everything in the LLREF buckets
+                        if( taskLLREF_IS_READY( pxCurrentTCBs[ uxCore ] ) )
+                        {
+                            xRank = listGET_LIST_ITEM_VALUE( &( pxCurrentTCBs[ uxCore ]->xStateListItem ) );
+                        }
+                        else
+                        {
+                            xRank = portMAX_DELAY;
+                        }
 
-                        if( ( xExecutionTime < xLowestExecutionTime ) &&
+                        if( ( xRank > xLowestRank ) &&
                             ( taskTASK_IS_RUNNING( pxCurrentTCBs[ uxCore ] ) != pdFALSE ) &&
                             ( xYieldPendings[ uxCore ] == pdFALSE ) )
                         {
-                            xLowestExecutionTime = xExecutionTime;
+                            xLowestRank = xRank;
                             xLowestExecutionTimeCore = (BaseType_t)uxCore;
                         } 
                     }
@@ -1250,6 +1512,56 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
     }
 /*-----------------------------------------------------------*/
 
+    TaskHandle_t xTaskCreatePeriodicStatic( TaskFunction_t pxTaskCode,
+                                            const char * const pcName,
+                                            const configSTACK_DEPTH_TYPE uxStackDepth,
+                                            void * const pvParameters,
+                                            TickType_t xPeriod,
+                                            TickType_t xWorstCaseExecutionTime,
+                                            StackType_t * const puxStackBuffer,
+                                            StaticTask_t * const pxTaskBuffer )
+    {
+        TaskHandle_t xReturn = NULL;
+        TCB_t * pxNewTCB;
+
+        traceENTER_xTaskCreatePeriodicStatic( pxTaskCode, pcName, uxStackDepth, pvParameters, xPeriod, xWorstCaseExecutionTime, puxStackBuffer, pxTaskBuffer );
+
+        configASSERT( xPeriod > ( TickType_t ) 0U );
+        configASSERT( xWorstCaseExecutionTime > ( TickType_t ) 0U );
+
+        pxNewTCB = prvCreateStaticTask( pxTaskCode, pcName, uxStackDepth, pvParameters, xWorstCaseExecutionTime, puxStackBuffer, pxTaskBuffer, &xReturn );
+
+        if( pxNewTCB != NULL )
+        {
+            #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+            {
+                /* Set the task's affinity before scheduling it. */
+                pxNewTCB->uxCoreAffinityMask = configTASK_DEFAULT_CORE_AFFINITY;
+            }
+            #endif
+
+            pxNewTCB->xPeriod = xPeriod;
+            pxNewTCB->xWorstCaseExecutionTime = xWorstCaseExecutionTime;
+            pxNewTCB->ulUtilization = prvTaskUtilization( pxNewTCB );
+
+            if( prvAddNewTaskToReadyList( pxNewTCB ) == pdFAIL )
+            {
+                /* The task was not admitted.  The buffers belong to the
+                 * caller, so there is nothing to free. */
+                xReturn = NULL;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceRETURN_xTaskCreatePeriodicStatic( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
     #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
         TaskHandle_t xTaskCreateStaticAffinitySet( TaskFunction_t pxTaskCode,
                                                    const char * const pcName,
@@ -1659,6 +1971,70 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
     }
 /*-----------------------------------------------------------*/
 
+    BaseType_t xTaskCreatePeriodic( TaskFunction_t pxTaskCode,
+                                    const char * const pcName,
+                                    const configSTACK_DEPTH_TYPE uxStackDepth,
+                                    void * const pvParameters,
+                                    TickType_t xPeriod,
+                                    TickType_t xWorstCaseExecutionTime,
+                                    TaskHandle_t * const pxCreatedTask )
+    {
+        TCB_t * pxNewTCB;
+        BaseType_t xReturn;
+
+        traceENTER_xTaskCreatePeriodic( pxTaskCode, pcName, uxStackDepth, pvParameters, xPeriod, xWorstCaseExecutionTime, pxCreatedTask );
+
+        configASSERT( xPeriod > ( TickType_t ) 0U );
+        configASSERT( xWorstCaseExecutionTime > ( TickType_t ) 0U );
+
+        pxNewTCB = prvCreateTask( pxTaskCode, pcName, uxStackDepth, pvParameters, xWorstCaseExecutionTime, pxCreatedTask );
+
+        if( pxNewTCB != NULL )
+        {
+            #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+            {
+                /* Set the task's affinity before scheduling it. */
+                pxNewTCB->uxCoreAffinityMask = configTASK_DEFAULT_CORE_AFFINITY;
+            }
+            #endif
+
+            pxNewTCB->xPeriod = xPeriod;
+            pxNewTCB->xWorstCaseExecutionTime = xWorstCaseExecutionTime;
+            pxNewTCB->ulUtilization = prvTaskUtilization( pxNewTCB );
+
+            if( prvAddNewTaskToReadyList( pxNewTCB ) != pdFAIL )
+            {
+                xReturn = pdPASS;
+            }
+            else
+            {
+                #if ( configADMISSION_CONTROL == ADMISSION_CONTROL_REJECT )
+                {
+                    /* The task was not admitted, so was never added to a
+                     * list. */
+                    if( pxCreatedTask != NULL )
+                    {
+                        *pxCreatedTask = NULL;
+                    }
+
+                    prvDeleteTCB( pxNewTCB );
+                }
+                #endif
+
+                xReturn = errTASK_NOT_ADMITTED;
+            }
+        }
+        else
+        {
+            xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+        }
+
+        traceRETURN_xTaskCreatePeriodic( xReturn );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
     #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
         BaseType_t xTaskCreateAffinitySet( TaskFunction_t pxTaskCode,
                                            const char * const pcName,
@@ -1700,31 +2076,18 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 #if configNUMBER_OF_CORES == 1
 static TCB_t *pxSelectLLREFTask(void)
 {
-    TCB_t *pxBestTask = NULL;
-    TickType_t xMaxRemainingTime = 0;
-    TickType_t xNow = xTaskGetTickCount();
-
-    ListItem_t *pxListItem;
-    TCB_t *pxTCB;
-
-    const ListItem_t * pxEndMarker = listGET_END_MARKER( &xReadyTaskListLLREF );
+    TCB_t *pxBestTask;
+    ListItem_t *pxHead = prvLLREFHead();
 
-    for( pxListItem = listGET_HEAD_ENTRY( &xReadyTaskListLLREF ); pxListItem != pxEndMarker; pxListItem = listGET_NEXT( pxListItem ) )
+    // LLREF: The ready buckets are kept in order, so the head is the task with
+    // the most local remaining execution time
+    if( pxHead != NULL )
     {
-        pxTCB = ( TCB_t* ) listGET_LIST_ITEM_OWNER(pxListItem);
-
-        // LLREF: Pick the task with the largest remaining execution time
-        if (pxTCB->xRemainingExecutionTime >= xMaxRemainingTime)
-        {
-            xMaxRemainingTime = pxTCB->xRemainingExecutionTime;
-            pxBestTask = pxTCB;
-            break;
-        }
+        pxBestTask = ( TCB_t* )listGET_LIST_ITEM_OWNER( pxHead );
     }
-
-    // No task found, look for the idle task
-    if( pxBestTask == NULL )
+    else
     {
+        // No task found, look for the idle task
         pxBestTask = ( TCB_t* )listGET_OWNER_OF_HEAD_ENTRY( &xReadyIdleTasks );
     }
 
@@ -1923,6 +2286,7 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     #if ( configNUMBER_OF_CORES > 1 )
     {
         pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+        pxNewTCB->xLastCoreID = -1;
 
         /* Is this an idle task? */
         if( ( ( TaskFunction_t ) pxTaskCode == ( TaskFunction_t ) ( &prvIdleTask ) ) || ( ( TaskFunction_t ) pxTaskCode == ( TaskFunction_t ) ( &prvPassiveIdleTask ) ) )
@@ -1947,141 +2311,1041 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
 #if ( configNUMBER_OF_CORES == 1 )
 
-    static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+    static BaseType_t prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
+        BaseType_t xReturn;
+
         /* Ensure interrupts don't access the task lists while the lists are being
          * updated. */
         taskENTER_CRITICAL();
         {
-            uxCurrentNumberOfTasks = ( UBaseType_t ) ( uxCurrentNumberOfTasks + 1U );
+            xReturn = prvAdmitTask( pxNewTCB );
 
-            if( pxCurrentTCB == NULL )
+            if( xReturn != pdFAIL )
             {
-                /* There are no other tasks, or all the other tasks are in
-                 * the suspended state - make this the current task. */
-                pxCurrentTCB = pxNewTCB;
+                uxCurrentNumberOfTasks = ( UBaseType_t ) ( uxCurrentNumberOfTasks + 1U );
 
-                if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+                if( pxCurrentTCB == NULL )
                 {
-                    /* This is the first task to be created so do the preliminary
-                     * initialisation required.  We will not recover if this call
-                     * fails, but we will report the failure. */
-                    prvInitialiseTaskLists();
+                    /* There are no other tasks, or all the other tasks are in
+                     * the suspended state - make this the current task. */
+                    pxCurrentTCB = pxNewTCB;
+
+                    if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+                    {
+                        /* This is the first task to be created so do the preliminary
+                         * initialisation required.  We will not recover if this call
+                         * fails, but we will report the failure. */
+                        prvInitialiseTaskLists();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
-            {
-                /* If the scheduler is not already running, make this task the
-                 * current task if it is the highest priority task to be created
-                 * so far. */
-                if( xSchedulerRunning == pdFALSE )
-                {
-                    if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                    /* If the scheduler is not already running, make this task the
+                     * current task if it is the highest priority task to be created
+                     * so far. */
+                    if( xSchedulerRunning == pdFALSE )
                     {
-                        pxCurrentTCB = pxNewTCB;
+                        if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                        {
+                            pxCurrentTCB = pxNewTCB;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                else
+
+                uxTaskNumber++;
+
+                #if ( configUSE_TRACE_FACILITY == 1 )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* Add a counter into the TCB for tracing only. */
+                    pxNewTCB->uxTCBNumber = uxTaskNumber;
                 }
-            }
+                #endif /* configUSE_TRACE_FACILITY */
+                traceTASK_CREATE( pxNewTCB );
 
-            uxTaskNumber++;
+                /* The first job of a periodic task is released now. */
+                pxNewTCB->xReleaseTime = xTickCount;
+                prvAddTaskToReadyList( pxNewTCB );
 
-            #if ( configUSE_TRACE_FACILITY == 1 )
-            {
-                /* Add a counter into the TCB for tracing only. */
-                pxNewTCB->uxTCBNumber = uxTaskNumber;
+                portSETUP_TCB( pxNewTCB );
             }
-            #endif /* configUSE_TRACE_FACILITY */
-            traceTASK_CREATE( pxNewTCB );
+        }
+        taskEXIT_CRITICAL();
+
+        if( ( xReturn != pdFAIL ) && ( xSchedulerRunning != pdFALSE ) )
+        {
+            /* If the created task is of a higher priority than the current task
+             * then it should run now. */
+            taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxNewTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
 
-            prvAddTaskToReadyList( pxNewTCB );
+#else /* #if ( configNUMBER_OF_CORES == 1 ) */
 
-            portSETUP_TCB( pxNewTCB );
+    static BaseType_t prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+    {
+        BaseType_t xReturn;
+
+        /* Ensure interrupts don't access the task lists while the lists are being
+         * updated. */
+        taskENTER_CRITICAL();
+        {
+            xReturn = prvAdmitTask( pxNewTCB );
+
+            if( xReturn != pdFAIL )
+            {
+                uxCurrentNumberOfTasks++;
+
+                if( xSchedulerRunning == pdFALSE )
+                {
+                    if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+                    {
+                        /* This is the first task to be created so do the preliminary
+                         * initialisation required.  We will not recover if this call
+                         * fails, but we will report the failure. */
+                        prvInitialiseTaskLists();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* All the cores start with idle tasks before the SMP scheduler
+                     * is running. Idle tasks are assigned to cores when they are
+                     * created in prvCreateIdleTasks(). */
+                }
+
+                uxTaskNumber++;
+
+                #if ( configUSE_TRACE_FACILITY == 1 )
+                {
+                    /* Add a counter into the TCB for tracing only. */
+                    pxNewTCB->uxTCBNumber = uxTaskNumber;
+                }
+                #endif /* configUSE_TRACE_FACILITY */
+                traceTASK_CREATE( pxNewTCB );
+
+                /* The first job of a periodic task is released now. */
+                pxNewTCB->xReleaseTime = xTickCount;
+                prvAddTaskToReadyList( pxNewTCB );
+
+                portSETUP_TCB( pxNewTCB );
+
+                if( xSchedulerRunning != pdFALSE )
+                {
+                    /* If the created task is of a higher priority than another
+                     * currently running task and preemption is on then it should
+                     * run now. */
+                    taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxNewTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+/*-----------------------------------------------------------*/
+
+static uint32_t prvTaskUtilization( const TCB_t * pxTCB )
+{
+    uint64_t ullUtilization = 0U;
+
+    if( pxTCB->xPeriod != ( TickType_t ) 0U )
+    {
+        ullUtilization = ( ( uint64_t ) pxTCB->xWorstCaseExecutionTime * taskUTILIZATION_ONE ) / pxTCB->xPeriod;
+    }
+
+    /* Stop the sum overflowing, a task this large is never admissible. */
+    if( ullUtilization > taskUTILIZATION_MAX )
+    {
+        ullUtilization = taskUTILIZATION_MAX;
+    }
+
+    return ( uint32_t ) ullUtilization;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvAdmitTask( const TCB_t * pxTCB )
+{
+    const uint32_t ulUtilization = prvTaskUtilization( pxTCB );
+    BaseType_t xReturn = pdPASS;
+
+    if( ( ulUtilization > taskUTILIZATION_ONE ) ||
+        ( ( ulUtilization > 0U ) && ( ( ulAdmittedUtilization + ulUtilization ) > taskADMISSION_BOUND ) ) )
+    {
+        traceTASK_ADMISSION_FAILED( pxTCB );
+
+        #if ( configADMISSION_CONTROL == ADMISSION_CONTROL_REJECT )
+        {
+            xReturn = pdFAIL;
+        }
+        #endif
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xReturn != pdFAIL )
+    {
+        ulAdmittedUtilization += ulUtilization;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReleaseTask( const TCB_t * pxTCB )
+{
+    ulAdmittedUtilization -= prvTaskUtilization( pxTCB );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvLLREFLocalShare( const TCB_t * pxTCB,
+                                    TickType_t xNow,
+                                    TickType_t xLength )
+{
+    uint64_t ullShare;
+    uint64_t ullAfter;
+    uint32_t ulUtilization = pxTCB->ulUtilization;
+    const TickType_t xUntilDeadline = ( pxTCB->xReleaseTime + pxTCB->xPeriod ) - xNow;
+
+    #if ( configLLREF_CYCLE_ACCOUNTING == 1 )
+        const uint64_t ullCyclesPerTick = ( uint64_t ) configLLREF_CYCLES_PER_TICK;
+        const uint64_t ullRemaining = ( ( prvLLREFRemainingCycles( pxTCB ) * taskUTILIZATION_ONE ) + ullCyclesPerTick - 1U ) / ullCyclesPerTick;
+    #else
+        const uint64_t ullRemaining = ( uint64_t ) pxTCB->xRemainingExecutionTime * taskUTILIZATION_ONE;
+    #endif
+
+    /* A task that was admitted anyway can still only use one core. */
+    if( ulUtilization > taskUTILIZATION_ONE )
+    {
+        ulUtilization = taskUTILIZATION_ONE;
+    }
+
+    ullShare = ( uint64_t ) ulUtilization * xLength;
+
+    /* Events only fall on ticks, so a task can run past its share and leave
+     * the others short of theirs.  A job is given what it needs to be back on
+     * its rate by the end of the plane, less when it has run ahead and more
+     * when it has fallen behind, and a job whose deadline has passed is given
+     * all it has left. */
+    if( ( xUntilDeadline > xLength ) && ( xUntilDeadline < ( TickType_t ) ( portMAX_DELAY >> 1 ) ) )
+    {
+        ullAfter = ( uint64_t ) ulUtilization * ( xUntilDeadline - xLength );
+        ullShare = ( ullRemaining > ullAfter ) ? ( ullRemaining - ullAfter ) : 0U;
+    }
+    else
+    {
+        ullShare = ullRemaining;
+    }
+
+    /* Nor more than the plane, a task only runs on one core at a time. */
+    if( ullShare > ( ( uint64_t ) xLength * taskUTILIZATION_ONE ) )
+    {
+        ullShare = ( uint64_t ) xLength * taskUTILIZATION_ONE;
+    }
+
+    /* There is no point giving a job more than it has left to run. */
+    if( ullShare > ullRemaining )
+    {
+        ullShare = ullRemaining;
+    }
+
+    return ( uint32_t ) ullShare;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLLREFStartPlane( TickType_t xNow,
+                                TickType_t xLength )
+{
+    TickType_t xUntil;
+    ListItem_t * pxIterator;
+    ListItem_t * pxNext;
+    TCB_t * pxTCB;
+
+    /* The running tasks are given a new share below, what they ran of the
+     * old one is charged first. */
+    prvLLREFChargeRunning( xNow );
+
+    #if ( configLLREF_DP_FAIR == 1 )
+    {
+        xNextSliceOrderLLREF = ( TickType_t ) 1U;
+    }
+    #endif
+
+    /* A task that is unblocked inside the plane would arrive part way
+     * through it, so the plane ends there. */
+    xUntil = xNextTaskUnblockTime - xNow;
+
+    if( ( xUntil > ( TickType_t ) 0U ) && ( xUntil < xLength ) )
+    {
+        xLength = xUntil;
+    }
+
+    /* Find the first deadline, and take the periodic tasks out of the ready
+     * buckets as their place in them is about to change. */
+    for( pxIterator = prvLLREFHead(); pxIterator != NULL; pxIterator = pxNext )
+    {
+        pxNext = prvLLREFNext( pxIterator );
+        pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+        if( taskIS_PERIODIC( pxTCB ) )
+        {
+            /* Deadlines that have already been missed wrap to a large value
+             * and do not shorten the plane. */
+            xUntil = ( pxTCB->xReleaseTime + pxTCB->xPeriod ) - xNow;
+
+            if( ( xUntil > ( TickType_t ) 0U ) && ( xUntil < xLength ) )
+            {
+                xLength = xUntil;
+            }
+
+            #if ( configLLREF_DP_FAIR == 1 )
+            {
+                /* The running tasks come first in the new plane so they carry
+                 * on without being preempted at its start. */
+                if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+                {
+                    pxTCB->xSliceOrder = xNextSliceOrderLLREF;
+                    xNextSliceOrderLLREF++;
+                }
+                else
+                {
+                    pxTCB->xSliceOrder = portMAX_DELAY;
+                }
+            }
+            #endif /* #if ( configLLREF_DP_FAIR == 1 ) */
+
+            listREMOVE_ITEM( pxIterator );
+            listINSERT_END( &xPlaneResortList, pxIterator );
+        }
+    }
+
+    xPlaneEndLLREF = xNow + xLength;
+    traceTL_PLANE_START( xNow, xPlaneEndLLREF );
+
+    while( listLIST_IS_EMPTY( &xPlaneResortList ) == pdFALSE )
+    {
+        pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &xPlaneResortList );
+        listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+
+        pxTCB->ulLocalRemainingExecution = prvLLREFLocalShare( pxTCB, xNow, xLength );
+        pxTCB->xLocalPlaneEnd = xPlaneEndLLREF;
+
+        #if ( configLLREF_DP_FAIR == 1 )
+        {
+            prvLLREFSliceOrder( pxTCB, xLength );
+        }
+        #endif
+
+        prvLLREFInsert( pxTCB );
+    }
+
+    xRescheduleLLREF = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLLREFTaskReady( TCB_t * pxTCB )
+{
+    uint32_t ulShare;
+    TickType_t xUntilDeadline;
+    const TickType_t xNow = xTickCount;
+
+    /* Before the scheduler starts there is no plane, the first one is started
+     * by vTaskStartScheduler(). */
+    if( xSchedulerRunning != pdFALSE )
+    {
+        /* A job released part way through the plane can have its deadline
+         * inside it, in which case the plane has to end at that deadline. */
+        xUntilDeadline = ( pxTCB->xReleaseTime + pxTCB->xPeriod ) - xNow;
+
+        if( ( xUntilDeadline > ( TickType_t ) 0U ) && ( xUntilDeadline < ( TickType_t ) ( xPlaneEndLLREF - xNow ) ) )
+        {
+            prvLLREFStartPlane( xNow, xUntilDeadline );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ulShare = prvLLREFLocalShare( pxTCB, xNow, xPlaneEndLLREF - xNow );
+
+        /* A task that blocked earlier in the same plane does not get more than
+         * it had left when it blocked. */
+        if( ( pxTCB->xLocalPlaneEnd == xPlaneEndLLREF ) && ( pxTCB->ulLocalRemainingExecution < ulShare ) )
+        {
+            ulShare = pxTCB->ulLocalRemainingExecution;
+        }
+
+        #if ( configLLREF_DP_FAIR == 1 )
+        {
+            /* It keeps its place in the order if it already had one in this
+             * plane, and goes to the back if not. */
+            if( pxTCB->xLocalPlaneEnd != xPlaneEndLLREF )
+            {
+                pxTCB->xSliceOrder = portMAX_DELAY;
+            }
+        }
+        #endif
+
+        pxTCB->ulLocalRemainingExecution = ulShare;
+        pxTCB->xLocalPlaneEnd = xPlaneEndLLREF;
+
+        #if ( configLLREF_DP_FAIR == 1 )
+        {
+            prvLLREFSliceOrder( pxTCB, xPlaneEndLLREF - xNow );
+        }
+        #endif
+
+        xRescheduleLLREF = pdTRUE;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configLLREF_DP_FAIR == 1 )
+
+    static void prvLLREFSliceOrder( TCB_t * pxTCB,
+                                    TickType_t xPlaneLeft )
+    {
+        const TickType_t xShare = ( TickType_t ) ( ( pxTCB->ulLocalRemainingExecution + taskUTILIZATION_ONE - 1U ) / taskUTILIZATION_ONE );
+        const TickType_t xPastDeadline = xPlaneEndLLREF - ( pxTCB->xReleaseTime + pxTCB->xPeriod );
+
+        /* A share is only ever short by part of a tick, and a job due after
+         * the plane makes that up in the next one. */
+        if( ( pxTCB->ulLocalRemainingExecution > 0U ) && ( xShare >= xPlaneLeft ) &&
+            ( xPastDeadline < ( TickType_t ) ( portMAX_DELAY >> 1 ) ) )
+        {
+            /* It cannot wait at all without missing its deadline. */
+            pxTCB->xSliceOrder = ( TickType_t ) 0U;
+        }
+        else if( pxTCB->xSliceOrder == portMAX_DELAY )
+        {
+            pxTCB->xSliceOrder = xNextSliceOrderLLREF;
+            xNextSliceOrderLLREF++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvLLREFPromoteZeroLaxity( TickType_t xNow )
+    {
+        ListItem_t * pxIterator;
+        ListItem_t * pxNext;
+        TCB_t * pxTCB;
+
+        /* The periodic tasks with share left are all in the first bucket, in
+         * front of everything else. */
+        for( pxIterator = prvLLREFHead(); pxIterator != NULL; pxIterator = pxNext )
+        {
+            pxNext = prvLLREFNext( pxIterator );
+            pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+            if( ( taskIS_PERIODIC( pxTCB ) == pdFALSE ) || ( pxTCB->ulLocalRemainingExecution == 0U ) )
+            {
+                break;
+            }
+
+            if( pxTCB->xSliceOrder != ( TickType_t ) 0U )
+            {
+                prvLLREFSliceOrder( pxTCB, xPlaneEndLLREF - xNow );
+
+                if( pxTCB->xSliceOrder == ( TickType_t ) 0U )
+                {
+                    listREMOVE_ITEM( pxIterator );
+                    prvLLREFInsert( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+    }
+
+#endif /* #if ( configLLREF_DP_FAIR == 1 ) */
+/*-----------------------------------------------------------*/
+
+static void prvLLREFCharge( BaseType_t xCoreID,
+                           TickType_t xNow )
+{
+    const TickType_t xElapsed = xNow - xChargedUntilLLREF[ xCoreID ];
+    TCB_t * pxTCB;
+
+    #if ( configNUMBER_OF_CORES == 1 )
+        ( void ) xCoreID;
+        pxTCB = pxCurrentTCB;
+    #else
+        pxTCB = pxCurrentTCBs[ xCoreID ];
+    #endif
+
+    #if ( configLLREF_CYCLE_ACCOUNTING == 1 )
+    {
+        const configLLREF_CYCLE_COUNT_TYPE xNowCycles = portLLREF_GET_CYCLE_COUNT();
+
+        ( void ) xElapsed;
+        prvLLREFChargeCycles( pxTCB, ( uint64_t ) ( configLLREF_CYCLE_COUNT_TYPE ) ( xNowCycles - xChargedCyclesLLREF[ xCoreID ] ) );
+        xChargedCyclesLLREF[ xCoreID ] = xNowCycles;
+    }
+    #else /* #if ( configLLREF_CYCLE_ACCOUNTING == 1 ) */
+    {
+        if( pxTCB->xRemainingExecutionTime > xElapsed )
+        {
+            pxTCB->xRemainingExecutionTime -= xElapsed;
+        }
+        else
+        {
+            pxTCB->xRemainingExecutionTime = 0U;
+        }
+
+        /* A share is never longer than a plane, so the product cannot wrap when
+         * the first test fails. */
+        if( ( xElapsed >= taskLLREF_MAX_PLANE_LENGTH ) ||
+            ( ( ( uint32_t ) xElapsed * taskUTILIZATION_ONE ) >= pxTCB->ulLocalRemainingExecution ) )
+        {
+            pxTCB->ulLocalRemainingExecution = 0U;
+        }
+        else
+        {
+            pxTCB->ulLocalRemainingExecution -= ( uint32_t ) xElapsed * taskUTILIZATION_ONE;
+        }
+    }
+    #endif /* #if ( configLLREF_CYCLE_ACCOUNTING == 1 ) */
+
+    xChargedUntilLLREF[ xCoreID ] = xNow;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configLLREF_CYCLE_ACCOUNTING == 1 )
+
+    static uint64_t prvLLREFRemainingCycles( const TCB_t * pxTCB )
+    {
+        return ( ( uint64_t ) pxTCB->xRemainingExecutionTime * ( uint64_t ) configLLREF_CYCLES_PER_TICK ) - pxTCB->ulConsumedCycles;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvLLREFChargeCycles( TCB_t * pxTCB,
+                                      uint64_t ullCycles )
+    {
+        const uint64_t ullCyclesPerTick = ( uint64_t ) configLLREF_CYCLES_PER_TICK;
+        uint64_t ullRemaining = prvLLREFRemainingCycles( pxTCB );
+        uint64_t ullLocal;
+
+        if( ullCycles < ullRemaining )
+        {
+            /* The tick count is rounded up so it only reaches 0 when the task
+             * has no time left at all, the part of the last tick already used
+             * is kept beside it. */
+            ullRemaining -= ullCycles;
+            pxTCB->xRemainingExecutionTime = ( TickType_t ) ( ( ullRemaining + ullCyclesPerTick - 1U ) / ullCyclesPerTick );
+            pxTCB->ulConsumedCycles = ( uint32_t ) ( ( ( uint64_t ) pxTCB->xRemainingExecutionTime * ullCyclesPerTick ) - ullRemaining );
+        }
+        else
+        {
+            pxTCB->xRemainingExecutionTime = 0U;
+            pxTCB->ulConsumedCycles = 0U;
+        }
+
+        /* The share of the plane is charged rounding up, so a task is never
+         * charged less than it ran.  A share is never longer than a plane, so
+         * the product cannot wrap when the first test fails. */
+        if( ullCycles >= ( ( uint64_t ) taskLLREF_MAX_PLANE_LENGTH * ullCyclesPerTick ) )
+        {
+            pxTCB->ulLocalRemainingExecution = 0U;
+        }
+        else
+        {
+            ullLocal = ( ( ullCycles * taskUTILIZATION_ONE ) + ullCyclesPerTick - 1U ) / ullCyclesPerTick;
+
+            if( ullLocal >= pxTCB->ulLocalRemainingExecution )
+            {
+                pxTCB->ulLocalRemainingExecution = 0U;
+            }
+            else
+            {
+                pxTCB->ulLocalRemainingExecution -= ( uint32_t ) ullLocal;
+            }
+        }
+    }
+
+#endif /* #if ( configLLREF_CYCLE_ACCOUNTING == 1 ) */
+/*-----------------------------------------------------------*/
+
+static void prvLLREFChargeRunning( TickType_t xNow )
+{
+    BaseType_t xCoreID;
+
+    for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+    {
+        prvLLREFCharge( xCoreID, xNow );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvLLREFSetNextEvent( TickType_t xNow )
+{
+    TickType_t xUntil = xPlaneEndLLREF - xNow;
+    TickType_t xPlaneLeft = xUntil;
+    TickType_t xRun;
+    TickType_t xElapsed;
+    uint32_t ulMostLocal = 0U;
+    BaseType_t xCoreID;
+    ListItem_t * pxIterator;
+    TCB_t * pxTCB;
+
+    /* B events, and jobs running out of execution time. */
+    for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+    {
+        #if ( configNUMBER_OF_CORES == 1 )
+            pxTCB = pxCurrentTCB;
+        #else
+            pxTCB = pxCurrentTCBs[ xCoreID ];
+        #endif
+
+        if( pxTCB->xRemainingExecutionTime > ( TickType_t ) 0U )
+        {
+            xRun = pxTCB->xRemainingExecutionTime;
+
+            if( pxTCB->ulLocalRemainingExecution > 0U )
+            {
+                xRun = ( TickType_t ) ( ( pxTCB->ulLocalRemainingExecution + taskUTILIZATION_ONE - 1U ) / taskUTILIZATION_ONE );
+            }
+
+            /* Other cores have not been charged up to now. */
+            xElapsed = xNow - xChargedUntilLLREF[ xCoreID ];
+
+            if( xRun > xElapsed )
+            {
+                xRun -= xElapsed;
+            }
+            else
+            {
+                xRun = ( TickType_t ) 1U;
+            }
+
+            if( xRun < xUntil )
+            {
+                xUntil = xRun;
+            }
+        }
+    }
+
+    /* The C event of the first waiting task.  No other waiting task has more
+     * local remaining execution, so none can hit the ceiling sooner.  The
+     * DP-Fair order is not by local remaining execution, so there every
+     * waiting task with share left is looked at. */
+    for( pxIterator = prvLLREFHead(); pxIterator != NULL; pxIterator = prvLLREFNext( pxIterator ) )
+    {
+        pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+        #if ( configLLREF_DP_FAIR == 1 )
+        {
+            if( ( taskIS_PERIODIC( pxTCB ) == pdFALSE ) || ( pxTCB->ulLocalRemainingExecution == 0U ) )
+            {
+                break;
+            }
+
+            if( ( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE ) && ( pxTCB->ulLocalRemainingExecution > ulMostLocal ) )
+            {
+                ulMostLocal = pxTCB->ulLocalRemainingExecution;
+            }
+        }
+        #else /* #if ( configLLREF_DP_FAIR == 1 ) */
+        {
+            if( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE )
+            {
+                if( ( taskIS_PERIODIC( pxTCB ) ) && ( pxTCB->ulLocalRemainingExecution > 0U ) )
+                {
+                    ulMostLocal = pxTCB->ulLocalRemainingExecution;
+                }
+
+                break;
+            }
+        }
+        #endif /* #if ( configLLREF_DP_FAIR == 1 ) */
+    }
+
+    if( ulMostLocal > 0U )
+    {
+        xRun = ( TickType_t ) ( ( ulMostLocal + taskUTILIZATION_ONE - 1U ) / taskUTILIZATION_ONE );
+
+        if( xRun < xPlaneLeft )
+        {
+            xRun = xPlaneLeft - xRun;
+        }
+        else
+        {
+            xRun = ( TickType_t ) 1U;
+        }
+
+        if( xRun < xUntil )
+        {
+            xUntil = xRun;
+        }
+    }
+
+    xNextEventLLREF = xNow + xUntil;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvLLREFBucket( const TCB_t * pxTCB )
+{
+    UBaseType_t uxBucket = taskLLREF_BUCKETS - 1U;
+    TickType_t xRemaining;
+
+    if( taskIS_PERIODIC( pxTCB ) )
+    {
+        /* A job that has used up its share still has to finish, in the first
+         * time the plane has spare. */
+        uxBucket = taskLLREF_SHARE_USED_BUCKET;
+
+        if( pxTCB->ulLocalRemainingExecution > 0U )
+        {
+            #if ( configLLREF_DP_FAIR == 1 )
+                /* The DP-Fair order does not follow the share, the first
+                 * bucket holds them all. */
+                uxBucket = 0U;
+            #else
+                uxBucket = 31U - taskLLREF_LOG2( pxTCB->ulLocalRemainingExecution );
+            #endif
+        }
+    }
+    else
+    {
+        /* Clamped the same way as in taskLLREF_ITEM_VALUE(). */
+        xRemaining = pxTCB->xRemainingExecutionTime;
+
+        if( xRemaining >= ( portMAX_DELAY >> 1 ) )
+        {
+            xRemaining = ( portMAX_DELAY >> 1 ) - ( TickType_t ) 1U;
+        }
+
+        if( xRemaining > ( TickType_t ) 0U )
+        {
+            uxBucket = ( taskLLREF_BUCKETS - 1U ) - taskLLREF_LOG2( ( uint32_t ) xRemaining );
+        }
+    }
+
+    return uxBucket;
+}
+/*-----------------------------------------------------------*/
+
+static void prvLLREFInsert( TCB_t * pxTCB )
+{
+    const UBaseType_t uxBucket = prvLLREFBucket( pxTCB );
+
+    listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), taskLLREF_ITEM_VALUE( pxTCB ) );
+    vListInsert( &( xReadyBucketsLLREF[ uxBucket ] ), &( pxTCB->xStateListItem ) );
+    ulReadyBucketsMapLLREF[ uxBucket >> 5 ] |= taskLLREF_BUCKET_BIT( uxBucket );
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvLLREFFirstBucket( UBaseType_t uxFrom )
+{
+    UBaseType_t uxWord;
+    UBaseType_t uxBucket;
+    uint32_t ulBits;
+
+    for( uxWord = uxFrom >> 5; uxWord < taskLLREF_BUCKET_WORDS; uxWord++ )
+    {
+        ulBits = ulReadyBucketsMapLLREF[ uxWord ];
+
+        if( uxWord == ( uxFrom >> 5 ) )
+        {
+            /* Leave out the buckets before uxFrom. */
+            ulBits &= ( ( uint32_t ) 0xFFFFFFFFUL >> ( uxFrom & 31U ) );
+        }
+
+        while( ulBits != 0U )
+        {
+            uxBucket = ( uxWord << 5 ) + ( 31U - taskLLREF_LOG2( ulBits ) );
+
+            if( listLIST_IS_EMPTY( &( xReadyBucketsLLREF[ uxBucket ] ) ) == pdFALSE )
+            {
+                return uxBucket;
+            }
+
+            /* The last task in the bucket was removed by code that only knows
+             * about lists, so the bit is cleared now. */
+            ulReadyBucketsMapLLREF[ uxWord ] &= ~taskLLREF_BUCKET_BIT( uxBucket );
+            ulBits &= ~taskLLREF_BUCKET_BIT( uxBucket );
+        }
+    }
+
+    return taskLLREF_BUCKETS;
+}
+/*-----------------------------------------------------------*/
+
+static ListItem_t * prvLLREFHead( void )
+{
+    const UBaseType_t uxBucket = prvLLREFFirstBucket( 0U );
+    ListItem_t * pxReturn = NULL;
+
+    if( uxBucket < taskLLREF_BUCKETS )
+    {
+        pxReturn = listGET_HEAD_ENTRY( &( xReadyBucketsLLREF[ uxBucket ] ) );
+    }
+
+    return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static ListItem_t * prvLLREFNext( const ListItem_t * pxItem )
+{
+    List_t * const pxBucket = listLIST_ITEM_CONTAINER( pxItem );
+    ListItem_t * pxReturn = listGET_NEXT( pxItem );
+    UBaseType_t uxBucket;
+
+    if( pxReturn == listGET_END_MARKER( pxBucket ) )
+    {
+        uxBucket = prvLLREFFirstBucket( ( UBaseType_t ) ( pxBucket - xReadyBucketsLLREF ) + 1U );
+        pxReturn = NULL;
+
+        if( uxBucket < taskLLREF_BUCKETS )
+        {
+            pxReturn = listGET_HEAD_ENTRY( &( xReadyBucketsLLREF[ uxBucket ] ) );
+        }
+    }
+
+    return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configLLREF_MINIMISE_MIGRATIONS == 1 )
+
+    static BaseType_t prvLLREFNear( const TCB_t * pxFirst,
+                                    const TCB_t * pxOther )
+    {
+        const TickType_t xFirstValue = listGET_LIST_ITEM_VALUE( &( pxFirst->xStateListItem ) );
+        const TickType_t xOtherValue = listGET_LIST_ITEM_VALUE( &( pxOther->xStateListItem ) );
+        BaseType_t xReturn = pdFALSE;
+
+        /* Tasks are only near each other in the same part of the order, a
+         * task that has used up its share never stands in for one that has
+         * not. */
+        if( taskIS_PERIODIC( pxFirst ) != taskIS_PERIODIC( pxOther ) )
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+        else if( ( xFirstValue == taskLLREF_SHARE_USED ) || ( xOtherValue == taskLLREF_SHARE_USED ) )
+        {
+            xReturn = ( xFirstValue == xOtherValue ) ? pdTRUE : pdFALSE;
+        }
+        else if( taskIS_PERIODIC( pxFirst ) )
+        {
+            /* Local remaining execution is in fractions of a tick. */
+            if( ( xOtherValue - xFirstValue ) <= ( ( TickType_t ) configLLREF_MIGRATION_EPSILON * ( TickType_t ) taskUTILIZATION_ONE ) )
+            {
+                xReturn = pdTRUE;
+            }
+        }
+        else
+        {
+            if( ( xOtherValue - xFirstValue ) <= ( TickType_t ) configLLREF_MIGRATION_EPSILON )
+            {
+                xReturn = pdTRUE;
+            }
+        }
+
+        return xReturn;
+    }
+
+#endif /* #if ( configLLREF_MINIMISE_MIGRATIONS == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if !defined( __GNUC__ )
+    static UBaseType_t prvLLREFLog2( uint32_t ulValue )
+    {
+        UBaseType_t uxBit = 0U;
+
+        while( ulValue > 1U )
+        {
+            ulValue >>= 1;
+            uxBit++;
+        }
+
+        return uxBit;
+    }
+#endif /* #if !defined( __GNUC__ ) */
+/*-----------------------------------------------------------*/
+
+static void prvLLREFResort( TCB_t * pxTCB )
+{
+    /* Charging a running task does not move it in the ready buckets, so it is
+     * put back at the place its local remaining execution now gives it.  It
+     * stays in the buckets even when it has no execution time left, the task
+     * still has to run to finish the job. */
+    if( taskLLREF_IS_READY( pxTCB ) )
+    {
+        const TickType_t xValue = taskLLREF_ITEM_VALUE( pxTCB );
+        List_t * const pxBucket = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+        const ListItem_t * pxNext = listGET_NEXT( &( pxTCB->xStateListItem ) );
+
+        listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), xValue );
+
+        /* Charging only ever moves a task back, so it only has to be moved
+         * when it has fallen into a later bucket or behind the task after it
+         * in its own. */
+        if( ( pxBucket != &( xReadyBucketsLLREF[ prvLLREFBucket( pxTCB ) ] ) ) ||
+            ( ( pxNext != listGET_END_MARKER( pxBucket ) ) && ( listGET_LIST_ITEM_VALUE( pxNext ) < xValue ) ) )
+        {
+            listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+            prvLLREFInsert( pxTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvLLREFReschedule( void )
+{
+    BaseType_t xSwitchRequired = pdFALSE;
+
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        prvLLREFResort( pxCurrentTCB );
+
+        #if ( configLLREF_DP_FAIR == 1 )
+        {
+            prvLLREFPromoteZeroLaxity( xTickCount );
         }
-        taskEXIT_CRITICAL();
+        #endif
 
-        if( xSchedulerRunning != pdFALSE )
+        const ListItem_t * pxHead = prvLLREFHead();
+
+        if( ( pxHead != NULL ) &&
+            ( listGET_LIST_ITEM_OWNER( pxHead ) != pxCurrentTCB ) )
         {
-            /* If the created task is of a higher priority than the current task
-             * then it should run now. */
-            taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxNewTCB );
+            xSwitchRequired = pdTRUE;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
     }
-
-#else /* #if ( configNUMBER_OF_CORES == 1 ) */
-
-    static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+    #else /* #if ( configNUMBER_OF_CORES == 1 ) */
     {
-        /* Ensure interrupts don't access the task lists while the lists are being
-         * updated. */
-        taskENTER_CRITICAL();
+        ListItem_t * pxIterator;
+        BaseType_t xCoreID;
+        BaseType_t xRank;
+        BaseType_t xInFirst[ configNUMBER_OF_CORES ];
+
+        for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
         {
-            uxCurrentNumberOfTasks++;
+            prvLLREFResort( pxCurrentTCBs[ xCoreID ] );
+            xInFirst[ xCoreID ] = pdFALSE;
+        }
 
-            if( xSchedulerRunning == pdFALSE )
-            {
-                if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
-                {
-                    /* This is the first task to be created so do the preliminary
-                     * initialisation required.  We will not recover if this call
-                     * fails, but we will report the failure. */
-                    prvInitialiseTaskLists();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+        #if ( configLLREF_DP_FAIR == 1 )
+        {
+            prvLLREFPromoteZeroLaxity( xTickCount );
+        }
+        #endif
 
-                /* All the cores start with idle tasks before the SMP scheduler
-                 * is running. Idle tasks are assigned to cores when they are
-                 * created in prvCreateIdleTasks(). */
-            }
+        /* Mark the cores that are running one of the first
+         * configNUMBER_OF_CORES tasks, those keep their task. */
+        xRank = 0;
 
-            uxTaskNumber++;
+        for( pxIterator = prvLLREFHead(); ( pxIterator != NULL ) && ( xRank < ( BaseType_t ) configNUMBER_OF_CORES ); pxIterator = prvLLREFNext( pxIterator ) )
+        {
+            const TCB_t * const pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
 
-            #if ( configUSE_TRACE_FACILITY == 1 )
+            if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
             {
-                /* Add a counter into the TCB for tracing only. */
-                pxNewTCB->uxTCBNumber = uxTaskNumber;
+                xInFirst[ pxTCB->xTaskRunState ] = pdTRUE;
             }
-            #endif /* configUSE_TRACE_FACILITY */
-            traceTASK_CREATE( pxNewTCB );
 
-            prvAddTaskToReadyList( pxNewTCB );
+            xRank++;
+        }
 
-            portSETUP_TCB( pxNewTCB );
+        /* Give each of the first tasks that is not running a core that is
+         * running a task outside them, the core picks the task itself when it
+         * yields.  The core the task last ran on is taken if it is free, so
+         * the task does not have to migrate. */
+        xRank = 0;
 
-            if( xSchedulerRunning != pdFALSE )
-            {
-                /* If the created task is of a higher priority than another
-                 * currently running task and preemption is on then it should
-                 * run now. */
-                taskYIELD_ANY_CORE_IF_USING_PREEMPTION( pxNewTCB );
-            }
-            else
+        for( pxIterator = prvLLREFHead(); ( pxIterator != NULL ) && ( xRank < ( BaseType_t ) configNUMBER_OF_CORES ); pxIterator = prvLLREFNext( pxIterator ) )
+        {
+            const TCB_t * const pxTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator );
+
+            if( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE )
             {
-                mtCOVERAGE_TEST_MARKER();
+                BaseType_t xTarget = -1;
+
+                #if ( configLLREF_MINIMISE_MIGRATIONS == 1 )
+                {
+                    if( ( pxTCB->xLastCoreID >= 0 ) && ( xInFirst[ pxTCB->xLastCoreID ] == pdFALSE ) )
+                    {
+                        xTarget = pxTCB->xLastCoreID;
+                    }
+                }
+                #endif
+
+                for( xCoreID = 0; ( xTarget < 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ); xCoreID++ )
+                {
+                    if( xInFirst[ xCoreID ] == pdFALSE )
+                    {
+                        xTarget = xCoreID;
+                    }
+                }
+
+                if( xTarget >= 0 )
+                {
+                    /* The core is taken, it is not offered to another task. */
+                    xInFirst[ xTarget ] = pdTRUE;
+                    xYieldPendings[ xTarget ] = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
+
+            xRank++;
         }
-        taskEXIT_CRITICAL();
     }
+    #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
 
-#endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+    return xSwitchRequired;
+}
 /*-----------------------------------------------------------*/
 
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
@@ -2154,6 +3418,8 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            prvReleaseTask( pxTCB );
+
             /* Increment the uxTaskNumber also so kernel aware debuggers can
              * detect that the task lists need re-generating.  This is done before
              * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -2412,6 +3678,121 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 #endif /* INCLUDE_vTaskDelay */
 /*-----------------------------------------------------------*/
 
+void vTaskWaitForNextPeriod( void )
+{
+    TCB_t * pxTCB;
+    TickType_t xNextRelease;
+    BaseType_t xAlreadyYielded;
+
+    traceENTER_vTaskWaitForNextPeriod();
+
+    vTaskSuspendAll();
+    {
+        /* Minor optimisation.  The tick count cannot change in this
+         * block. */
+        const TickType_t xConstTickCount = xTickCount;
+
+        pxTCB = pxCurrentTCB;
+
+        /* Only tasks created with xTaskCreatePeriodic() have a period. */
+        configASSERT( pxTCB->xPeriod > ( TickType_t ) 0U );
+
+        /* The next job is released one period after the current one, not one
+         * period after now, so the releases do not drift. */
+        xNextRelease = pxTCB->xReleaseTime + pxTCB->xPeriod;
+
+        /* The next job starts with all of its execution time.  What the
+         * current one ran since it was last charged still counts against its
+         * share of the plane. */
+        prvLLREFCharge( portGET_CORE_ID(), xConstTickCount );
+        pxTCB->xRemainingExecutionTime = pxTCB->xWorstCaseExecutionTime;
+
+        #if ( configLLREF_CYCLE_ACCOUNTING == 1 )
+        {
+            pxTCB->ulConsumedCycles = 0U;
+        }
+        #endif
+
+        if( ( TickType_t ) ( xConstTickCount - pxTCB->xReleaseTime ) < pxTCB->xPeriod )
+        {
+            pxTCB->xReleaseTime = xNextRelease;
+            traceTASK_DELAY_UNTIL( xNextRelease );
+            prvAddCurrentTaskToDelayedList( xNextRelease - xConstTickCount, pdFALSE );
+        }
+        else
+        {
+            /* The job overran its period so the next job has already been
+             * released.  The task stays ready, but has to be moved to the
+             * position of its new remaining execution time. */
+            pxTCB->xReleaseTime = xNextRelease;
+            ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+            prvAddTaskToReadyList( pxTCB );
+        }
+    }
+    xAlreadyYielded = xTaskResumeAll();
+
+    /* Force a reschedule if xTaskResumeAll has not already done so, we may
+     * have put ourselves to sleep. */
+    if( xAlreadyYielded == pdFALSE )
+    {
+        taskYIELD_WITHIN_API();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceRETURN_vTaskWaitForNextPeriod();
+}
+/*-----------------------------------------------------------*/
+
+int32_t lTaskGetAdmissionHeadroom( BaseType_t xCoreID )
+{
+    int32_t lHeadroom;
+
+    traceENTER_lTaskGetAdmissionHeadroom( xCoreID );
+
+    /* LLREF schedules all the cores together. */
+    ( void ) xCoreID;
+
+    taskENTER_CRITICAL();
+    {
+        lHeadroom = ( int32_t ) taskADMISSION_BOUND - ( int32_t ) ulAdmittedUtilization;
+    }
+    taskEXIT_CRITICAL();
+
+    traceRETURN_lTaskGetAdmissionHeadroom( lHeadroom );
+
+    return lHeadroom;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    UBaseType_t uxTaskGetMigrationCount( TaskHandle_t xTask )
+    {
+        const TCB_t * pxTCB;
+        UBaseType_t uxReturn;
+
+        traceENTER_uxTaskGetMigrationCount( xTask );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            configASSERT( pxTCB != NULL );
+
+            uxReturn = pxTCB->uxMigrations;
+        }
+        taskEXIT_CRITICAL();
+
+        traceRETURN_uxTaskGetMigrationCount( uxReturn );
+
+        return uxReturn;
+    }
+
+#endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
 
     eTaskState eTaskGetState( TaskHandle_t xTask )
@@ -3598,6 +4979,7 @@ static BaseType_t prvCreateIdleTasks( void )
 void vTaskStartScheduler( void )
 {
     BaseType_t xReturn;
+    BaseType_t xCoreID;
 
     traceENTER_vTaskStartScheduler();
 
@@ -3654,6 +5036,21 @@ void vTaskStartScheduler( void )
         xSchedulerRunning = pdTRUE;
         xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
 
+        /* Share out the first TL-plane between the tasks created so far. */
+        for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            xChargedUntilLLREF[ xCoreID ] = xTickCount;
+
+            #if ( configLLREF_CYCLE_ACCOUNTING == 1 )
+            {
+                xChargedCyclesLLREF[ xCoreID ] = portLLREF_GET_CYCLE_COUNT();
+            }
+            #endif
+        }
+
+        prvLLREFStartPlane( xTickCount, taskLLREF_MAX_PLANE_LENGTH );
+        prvLLREFSetNextEvent( xTickCount );
+
         /* If configGENERATE_RUN_TIME_STATS is defined then the following
          * macro must be defined to configure the timer/counter used to generate
          * the run time counter time base.   NOTE:  If configGENERATE_RUN_TIME_STATS
@@ -3858,57 +5255,55 @@ void vTaskSuspendAll( void )
     static TickType_t prvGetExpectedIdleTime( void )
     {
         TickType_t xReturn;
-        BaseType_t xHigherPriorityReadyTasks = pdFALSE;
+        TickType_t xUntilEvent;
+        UBaseType_t uxWord;
+        BaseType_t xOtherTasksReady = pdFALSE;
 
-        /* xHigherPriorityReadyTasks takes care of the case where
-         * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
-         * task that are in the Ready state, even though the idle task is
-         * running. */
-        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
-        {
-            if( uxTopReadyPriority > tskIDLE_PRIORITY )
-            {
-                xHigherPriorityReadyTasks = pdTRUE;
-            }
-        }
-        #else
+        /* Every ready task other than the idle tasks is either in the LLREF
+         * ready buckets or, once a task that is not periodic has no execution
+         * time left, in xReadyIdleTasks beside them.  The bucket bits are only
+         * looked at, not cleared as prvLLREFFirstBucket() does, as the
+         * scheduler may not be suspended. */
+        for( uxWord = 0U; uxWord < taskLLREF_BUCKET_WORDS; uxWord++ )
         {
-            const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
+            uint32_t ulBits = ulReadyBucketsMapLLREF[ uxWord ];
 
-            /* When port optimised task selection is used the uxTopReadyPriority
-             * variable is used as a bit map.  If bits other than the least
-             * significant bit are set then there are tasks that have a priority
-             * above the idle priority that are in the Ready state.  This takes
-             * care of the case where the co-operative scheduler is in use. */
-            if( uxTopReadyPriority > uxLeastSignificantBit )
+            while( ulBits != 0U )
             {
-                xHigherPriorityReadyTasks = pdTRUE;
+                const UBaseType_t uxBucket = ( uxWord << 5 ) + ( 31U - taskLLREF_LOG2( ulBits ) );
+
+                if( listLIST_IS_EMPTY( &( xReadyBucketsLLREF[ uxBucket ] ) ) == pdFALSE )
+                {
+                    xOtherTasksReady = pdTRUE;
+                }
+
+                ulBits &= ~taskLLREF_BUCKET_BIT( uxBucket );
             }
         }
-        #endif /* if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) */
 
-        if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
+        if( xOtherTasksReady != pdFALSE )
         {
             xReturn = 0;
         }
-        else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > 1U )
+        else if( listCURRENT_LIST_LENGTH( &xReadyIdleTasks ) > ( UBaseType_t ) configNUMBER_OF_CORES )
         {
-            /* There are other idle priority tasks in the ready state.  If
-             * time slicing is used then the very next tick interrupt must be
-             * processed. */
-            xReturn = 0;
-        }
-        else if( xHigherPriorityReadyTasks != pdFALSE )
-        {
-            /* There are tasks in the Ready state that have a priority above the
-             * idle priority.  This path can only be reached if
-             * configUSE_PREEMPTION is 0. */
+            /* A task with no execution time left shares the idle tasks'
+             * place and runs in turn with them. */
             xReturn = 0;
         }
         else
         {
+            /* Sleep until a task is unblocked or the next LLREF event, which
+             * is at latest the end of the plane. */
             xReturn = xNextTaskUnblockTime;
             xReturn -= xTickCount;
+
+            xUntilEvent = xNextEventLLREF - xTickCount;
+
+            if( xUntilEvent < xReturn )
+            {
+                xReturn = xUntilEvent;
+            }
         }
 
         return xReturn;
@@ -4235,7 +5630,12 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
 
         vTaskSuspendAll();
         {
-            pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( xReadyTaskListLLREF ), pcNameToQuery );
+            pxTCB = NULL;
+
+            for( uxQueue = 0U; ( uxQueue < taskLLREF_BUCKETS ) && ( pxTCB == NULL ); uxQueue++ )
+            {
+                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( xReadyBucketsLLREF[ uxQueue ] ), pcNameToQuery );
+            }
 
             /* Search the delayed lists. */
             if( pxTCB == NULL )
@@ -4350,7 +5750,10 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
             {
                 /* Fill in an TaskStatus_t structure with information on each
                  * task in the Ready state. */
-                uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xReadyTaskListLLREF ), eReady ) );
+                for( uxQueue = 0U; uxQueue < taskLLREF_BUCKETS; uxQueue++ )
+                {
+                    uxTask = ( UBaseType_t ) ( uxTask + prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xReadyBucketsLLREF[ uxQueue ] ), eReady ) );
+                }
 
                 /* Fill in an TaskStatus_t structure with information on each
                  * task in the Blocked state. */
@@ -4462,11 +5865,12 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery )
         xUpdatedTickCount = xTickCount + xTicksToJump;
         configASSERT( xUpdatedTickCount <= xNextTaskUnblockTime );
 
-        if( xUpdatedTickCount == xNextTaskUnblockTime )
+        if( ( xUpdatedTickCount == xNextTaskUnblockTime ) || ( xUpdatedTickCount == xNextEventLLREF ) )
         {
             /* Arrange for xTickCount to reach xNextTaskUnblockTime in
              * xTaskIncrementTick() when the scheduler resumes.  This ensures
-             * that any delayed tasks are resumed at the correct time. */
+             * that any delayed tasks are resumed at the correct time, and that
+             * an LLREF event due at that tick is handled on it. */
             configASSERT( uxSchedulerSuspended != ( UBaseType_t ) 0U );
             configASSERT( xTicksToJump != ( TickType_t ) 0 );
 
@@ -4621,7 +6025,7 @@ BaseType_t xTaskIncrementTick( void )
     TCB_t * pxTCB;
     TickType_t xItemValue;
     BaseType_t xSwitchRequired = pdFALSE;
-    TickType_t xCurrentRemainingTime;
+    BaseType_t xScheduleEvent = pdFALSE;
     BaseType_t xCoreID;
 
     //printf("Tick\n");
@@ -4719,86 +6123,47 @@ BaseType_t xTaskIncrementTick( void )
                      * list. */
                     prvAddTaskToReadyList( pxTCB );
 
-                    /* A task being unblocked cannot cause an immediate
-                     * context switch if preemption is turned off. */
-                    #if ( configUSE_PREEMPTION == 1 )
-                    {
-                        #if ( configNUMBER_OF_CORES == 1 )
-                        {
-                            /* Preemption is on, but a context switch should
-                             * only be performed if the unblocked task's
-                             * priority is higher than the currently executing
-                             * task.
-                             * The case of equal priority tasks sharing
-                             * processing time (which happens when both
-                             * preemption and time slicing are on) is
-                             * handled below.*/
-                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                            {
-                                printf("Unblocked task about to cause switch\n");
-                                xSwitchRequired = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        #else /* #if( configNUMBER_OF_CORES == 1 ) */
-                        {
-                            prvYieldForTask( pxTCB );
-                        }
-                        #endif /* #if( configNUMBER_OF_CORES == 1 ) */
-                    }
-                    #endif /* #if ( configUSE_PREEMPTION == 1 ) */
+                    /* An arrival is a scheduling event. */
+                    xScheduleEvent = pdTRUE;
                 }
             }
         }
 
-#if configNUMBER_OF_CORES == 1
-        xCurrentRemainingTime = pxCurrentTCB->xRemainingExecutionTime - ( xConstTickCount - ulSwitchInTimeLLREF[ 0 ] );
-
-        if( listCURRENT_LIST_LENGTH( &xReadyTaskListLLREF ) > 1U )
+        /* Between events the only LLREF work is this test.  It is written so
+         * that an event that was stepped over still counts. */
+        if( ( ( TickType_t ) ( xConstTickCount - xNextEventLLREF ) < ( TickType_t ) ( portMAX_DELAY >> 1 ) ) ||
+            ( xScheduleEvent != pdFALSE ) ||
+            ( xRescheduleLLREF != pdFALSE ) )
         {
-            // There are other tasks than the one running, the head should always be the currently
-            // running task since it had the highest remaining execution time
-            // Let's get the second highest execution time and compare to it
-            ListItem_t* pxSecondHighestItem;
-            TCB_t* pxSecondHighestTCB;
+            xRescheduleLLREF = pdFALSE;
+            prvLLREFChargeRunning( xConstTickCount );
 
-            pxSecondHighestItem = listGET_NEXT( listGET_HEAD_ENTRY( &xReadyTaskListLLREF ) );
-            pxSecondHighestTCB = ( TCB_t* )listGET_LIST_ITEM_OWNER( pxSecondHighestItem );
-
-            if( pxSecondHighestTCB->xRemainingExecutionTime > xCurrentRemainingTime )
+            if( ( TickType_t ) ( xConstTickCount - xPlaneEndLLREF ) < ( TickType_t ) ( portMAX_DELAY >> 1 ) )
             {
-                // Switch out
-                xSwitchRequired = pdTRUE;
+                prvLLREFStartPlane( xConstTickCount, taskLLREF_MAX_PLANE_LENGTH );
             }
-        }
-#else
-        for ( xCoreID = 0; xCoreID < ( ( BaseType_t ) configNUMBER_OF_CORES ); xCoreID++ )
-        {
-            xCurrentRemainingTime = pxCurrentTCBs[ xCoreID ]->xRemainingExecutionTime - ( xConstTickCount - ulSwitchInTimeLLREF[ xCoreID ] );
-
-            if( listCURRENT_LIST_LENGTH( &xReadyTaskListLLREF ) > 1U )
+            else
             {
-                // Let's see if there is another unscheduled task with a higher execution time
-
-                const ListItem_t * pxEndMarker = listGET_END_MARKER( &xReadyTaskListLLREF );
-                ListItem_t * pxIterator;
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-                for( pxIterator = listGET_HEAD_ENTRY( &xReadyTaskListLLREF ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+            /* LLREF only chooses which tasks run at an event, between events
+             * the running tasks are left alone. */
+            #if ( configUSE_PREEMPTION == 1 )
+            {
+                if( prvLLREFReschedule() != pdFALSE )
                 {
-                    pxTCB = ( TCB_t* )listGET_LIST_ITEM_OWNER( pxIterator );
-
-                    if( pxTCB->xRemainingExecutionTime > xCurrentRemainingTime &&
-                        taskTASK_IS_RUNNING( pxTCB ) != pdTRUE )
-                    {
-                        xYieldPendings[ xCoreID ] = pdTRUE; // This core should switch to the highest remaining execution time
-                    }
+                    xSwitchRequired = pdTRUE;
                 }
             }
+            #endif /* #if ( configUSE_PREEMPTION == 1 ) */
+
+            prvLLREFSetNextEvent( xConstTickCount );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-#endif
 
         #if ( configUSE_TICK_HOOK == 1 )
         {
@@ -5017,8 +6382,6 @@ BaseType_t xTaskIncrementTick( void )
 #if ( configNUMBER_OF_CORES == 1 )
     void vTaskSwitchContext( void )
     {
-        TickType_t xCurrentTime;
-
         traceENTER_vTaskSwitchContext();
 
         if( uxSchedulerSuspended != ( UBaseType_t ) 0U )
@@ -5060,33 +6423,10 @@ BaseType_t xTaskIncrementTick( void )
             }
             #endif /* configGENERATE_RUN_TIME_STATS */
 
-            xCurrentTime = xTaskGetTickCount();
-            if( xCurrentTime > ulSwitchInTimeLLREF[0] ) 
-            {
-                if( pxCurrentTCB->xRemainingExecutionTime > ( xCurrentTime - ulSwitchInTimeLLREF[ 0 ] ) )
-                {
-                    pxCurrentTCB->xRemainingExecutionTime -= ( xCurrentTime - ulSwitchInTimeLLREF[ 0 ] );
-                }
-                else
-                {
-                    pxCurrentTCB->xRemainingExecutionTime = 0; // We would underflow 
-                }
-
-                // This is kind of stupid but it will work
-                // To keep the list in sorted order of execution times we just remove it from the list then add it back
-                // If it's not in the ready to run list it will be updated when it is added back
-                if( listIS_CONTAINED_WITHIN( &xReadyTaskListLLREF, &pxCurrentTCB->xStateListItem) != pdFALSE )
-                {
-                    // It is in the ready to run list
-                    listREMOVE_ITEM( &pxCurrentTCB->xStateListItem );
-                    // Update the value
-                    listSET_LIST_ITEM_VALUE( &pxCurrentTCB->xStateListItem, (TickType_t)-1 - pxCurrentTCB->xRemainingExecutionTime);
-                    // Now we can add it back
-                    vListInsert( &xReadyTaskListLLREF, &pxCurrentTCB->xStateListItem);
-                }
-
-            }
-            ulSwitchInTimeLLREF[0] = xCurrentTime;
+            /* Charge the task for the time it ran and put it back in order
+             * before the next one is chosen. */
+            prvLLREFCharge( 0, xTickCount );
+            prvLLREFResort( pxCurrentTCB );
 
             /* Check for stack overflow, if configured. */
             taskCHECK_FOR_STACK_OVERFLOW();
@@ -5104,6 +6444,7 @@ BaseType_t xTaskIncrementTick( void )
             /* More details at: https://github.com/FreeRTOS/FreeRTOS-Kernel/blob/main/MISRA.md#rule-115 */
             /* coverity[misra_c_2012_rule_11_5_violation] */
             taskSELECT_HIGHEST_PRIORITY_TASK();
+            prvLLREFSetNextEvent( xTickCount );
             traceTASK_SWITCHED_IN();
 
             /* Macro to inject port specific behaviour immediately after
@@ -5132,8 +6473,6 @@ BaseType_t xTaskIncrementTick( void )
 #else /* if ( configNUMBER_OF_CORES == 1 ) */
     void vTaskSwitchContext( BaseType_t xCoreID )
     {
-        TickType_t xCurrentTime;
-
         traceENTER_vTaskSwitchContext();
 
         /* Acquire both locks:
@@ -5191,30 +6530,10 @@ BaseType_t xTaskIncrementTick( void )
                 }
                 #endif /* configGENERATE_RUN_TIME_STATS */
 
-                xCurrentTime = xTaskGetTickCount();
-                if( xCurrentTime > ulSwitchInTimeLLREF[ xCoreID ] )
-                {
-                    if( pxCurrentTCBs[ xCoreID ]->xRemainingExecutionTime > ( xCurrentTime - ulSwitchInTimeLLREF[ xCoreID ] ) )
-                    {
-                        pxCurrentTCBs[ xCoreID ]->xRemainingExecutionTime -= ( xCurrentTime - ulSwitchInTimeLLREF[ xCoreID ] );
-                    }
-                    else
-                    {
-                        pxCurrentTCBs[ xCoreID ]->xRemainingExecutionTime = 0; // We would underflow
-                    }
-
-                    // Same stupid things as last time
-                    if ( listIS_CONTAINED_WITHIN( &xReadyTaskListLLREF, &( pxCurrentTCBs[ xCoreID ]->xStateListItem ) ) != pdFALSE )
-                    {
-                        // Remove from the ready list
-                        listREMOVE_ITEM( &( pxCurrentTCBs[ xCoreID ]->xStateListItem ) );
-                        // Update the value
-                        listSET_LIST_ITEM_VALUE( &( pxCurrentTCBs[ xCoreID ]->xStateListItem ), (TickType_t)-1 - pxCurrentTCBs[ xCoreID ]->xRemainingExecutionTime );
-                        // Add it back
-                        vListInsert( &xReadyTaskListLLREF, &( pxCurrentTCBs[ xCoreID ]->xStateListItem ) );
-                    }
-                }
-                ulSwitchInTimeLLREF[ xCoreID ] = xCurrentTime;
+                /* Charge the task for the time it ran and put it back in
+                 * order before the next one is chosen. */
+                prvLLREFCharge( xCoreID, xTickCount );
+                prvLLREFResort( pxCurrentTCBs[ xCoreID ] );
 
                 /* Check for stack overflow, if configured. */
                 taskCHECK_FOR_STACK_OVERFLOW();
@@ -5228,6 +6547,19 @@ BaseType_t xTaskIncrementTick( void )
 
                 /* Select a new task to run. */
                 taskSELECT_HIGHEST_PRIORITY_TASK( xCoreID );
+                prvLLREFSetNextEvent( xTickCount );
+
+                if( ( pxCurrentTCBs[ xCoreID ]->xLastCoreID >= 0 ) && ( pxCurrentTCBs[ xCoreID ]->xLastCoreID != xCoreID ) )
+                {
+                    ( pxCurrentTCBs[ xCoreID ]->uxMigrations )++;
+                    traceTASK_MIGRATED( pxCurrentTCBs[ xCoreID ], pxCurrentTCBs[ xCoreID ]->xLastCoreID, xCoreID );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxCurrentTCBs[ xCoreID ]->xLastCoreID = xCoreID;
                 traceTASK_SWITCHED_IN();
 
                 /* Macro to inject port specific behaviour immediately after
@@ -6034,8 +7366,18 @@ static void prvInitialiseTaskLists( void )
 {
     UBaseType_t uxPriority;
 
-    vListInitialise( &xReadyTaskListLLREF );
+    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < taskLLREF_BUCKETS; uxPriority++ )
+    {
+        vListInitialise( &( xReadyBucketsLLREF[ uxPriority ] ) );
+    }
+
+    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < taskLLREF_BUCKET_WORDS; uxPriority++ )
+    {
+        ulReadyBucketsMapLLREF[ uxPriority ] = 0U;
+    }
+
     vListInitialise( &xReadyIdleTasks );
+    vListInitialise( &xPlaneResortList );
     vListInitialise( &xDelayedTaskList1 );
     vListInitialise( &xDelayedTaskList2 );
     vListInitialise( &xPendingReadyList );
@@ -6420,7 +7762,7 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_uxTaskGetStackHighWaterMark */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelete == 1 )
+#if ( ( INCLUDE_vTaskDelete == 1 ) || ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configADMISSION_CONTROL == ADMISSION_CONTROL_REJECT ) ) )
 
     static void prvDeleteTCB( TCB_t * pxTCB )
     {
@@ -8800,9 +10142,25 @@ void vTaskResetState( void )
     xSchedulerRunning = pdFALSE;
     xPendedTicks = ( TickType_t ) 0U;
 
-    for ( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
+    xPlaneEndLLREF = ( TickType_t ) 0U;
+    xRescheduleLLREF = pdFALSE;
+
+    #if ( configLLREF_DP_FAIR == 1 )
+    {
+        xNextSliceOrderLLREF = ( TickType_t ) 1U;
+    }
+    #endif
+    xNextEventLLREF = ( TickType_t ) 0U;
+
+    for( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
     {
-        ulSwitchInTimeLLREF[ xCoreID ] = 0U; 
+        xChargedUntilLLREF[ xCoreID ] = 0U;
+
+        #if ( configLLREF_CYCLE_ACCOUNTING == 1 )
+        {
+            xChargedCyclesLLREF[ xCoreID ] = 0U;
+        }
+        #endif
     }
 
     for( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
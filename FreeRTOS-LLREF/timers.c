@@ -261,7 +261,7 @@
                                                                      configTIMER_SERVICE_TASK_NAME,
                                                                      uxTimerTaskStackSize,
                                                                      NULL,
-                                                                     ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+                                                                     ( ( UBaseType_t ) configTIMER_TASK_EXECUTION_TIME ) | portPRIVILEGE_BIT,
                                                                      pxTimerTaskStackBuffer,
                                                                      pxTimerTaskTCBBuffer,
                                                                      configTIMER_SERVICE_TASK_CORE_AFFINITY );
@@ -277,7 +277,7 @@
                                                       configTIMER_SERVICE_TASK_NAME,
                                                       configTIMER_TASK_STACK_DEPTH,
                                                       NULL,
-                                                      ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+                                                      ( ( UBaseType_t ) configTIMER_TASK_EXECUTION_TIME ) | portPRIVILEGE_BIT,
                                                       configTIMER_SERVICE_TASK_CORE_AFFINITY,
                                                       &xTimerTaskHandle );
                 }
@@ -296,7 +296,7 @@
                                                           configTIMER_SERVICE_TASK_NAME,
                                                           uxTimerTaskStackSize,
                                                           NULL,
-                                                          ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+                                                          ( ( UBaseType_t ) configTIMER_TASK_EXECUTION_TIME ) | portPRIVILEGE_BIT,
                                                           pxTimerTaskStackBuffer,
                                                           pxTimerTaskTCBBuffer );
 
@@ -311,7 +311,7 @@
                                            configTIMER_SERVICE_TASK_NAME,
                                            configTIMER_TASK_STACK_DEPTH,
                                            NULL,
-                                           ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+                                           ( ( UBaseType_t ) configTIMER_TASK_EXECUTION_TIME ) | portPRIVILEGE_BIT,
                                            &xTimerTaskHandle );
                 }
                 #endif /* configSUPPORT_STATIC_ALLOCATION */
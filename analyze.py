@@ -1,93 +1,107 @@
 #!/usr/bin/python
-from enum import Enum
-import re
+# Makespan, turnaround, response time, preemptions and migrations from the
+# traces of benchmark runs. Each path is a run's output, a raw trace, or a
+# directory of them, and every trace in them is one set.
 import os
 import sys
+from collections import deque
 
-if len(sys.argv) != 2:
+import trace_format as tf
+
+if len(sys.argv) < 2:
     print("Missing analysis path")
     exit(1)
 
-NUM_TASKS = 8
-PATH = sys.argv[1]
-
-# In ms
-task_arrival_times = [[] for _ in range(NUM_TASKS)]
-task_start_times = [[] for _ in range(NUM_TASKS)]
-task_end_times = [[] for _ in range(NUM_TASKS)]
-
-def parse_file(f):
-    output_region = False
-    
-    for line in f:
-        if 'OUTPUT START' in line:
-            output_region = True
-        elif 'OUTPUT END' in line:
-            output_region = False
-        elif output_region:
-            # We are reading output
-            m = re.match(r'^(\d+) ms \| (\w+) task(\d+)$', line)
-            if m is None:
-                # No match
-                continue
-            
-            time = int(m.group(1))
-            action = m.group(2)
-            task = int(m.group(3))
-
-            if action == 'START':
-                task_start_times[task].append(time)
-            elif action == 'END':
-                task_end_times[task].append(time)
-            elif action == 'ARRIVE':
-                task_arrival_times[task].append(time)
 
-# Load in the files
-for path in os.listdir(PATH):
-    with open(os.path.join(PATH, path), 'r') as f:
-        parse_file(f)
-
-sets = len(task_start_times[0])
-
-# Veryify that everything has the same number of sets
-for i in range(NUM_TASKS):
-    if sets != len(task_start_times[i]) or sets != len(task_end_times[i]) or sets != len(task_arrival_times[i]):
-        print("Set length verification failed")
+def analyze(trace):
+    # One pass over the records, only per task and per core state is kept
+    pending = {}       # Arrival times of the jobs of each task not started yet
+    started = {}       # Arrival times of the started jobs of each task not finished yet
+    running = {}       # Task running on each core
+    last_core = {}     # Core each task last ran on
+    first_arrival = None
+    last_finish = None
+    jobs = 0
+    turnaround = 0
+    response = 0
+    preemptions = 0
+    migrations = 0
+
+    for time, task, core, kind in trace.records():
+        if kind == tf.JOB_ARRIVED:
+            pending.setdefault(task, deque()).append(time)
+            if first_arrival is None or time < first_arrival:
+                first_arrival = time
+        elif kind == tf.JOB_STARTED:
+            queue = pending.get(task)
+            # A job with no arrival recorded arrived when it started
+            arrival = queue.popleft() if queue else time
+            started.setdefault(task, deque()).append(arrival)
+            if first_arrival is None:
+                first_arrival = arrival
+            response += time - arrival
+        elif kind == tf.JOB_FINISHED:
+            queue = started.get(task)
+            arrival = queue.popleft() if queue else time
+            turnaround += time - arrival
+            jobs += 1
+            last_finish = time
+        elif kind == tf.SWITCHED_IN:
+            previous = running.get(core)
+            # Switched out part way through a job
+            if previous is not None and previous != task and started.get(previous):
+                preemptions += 1
+            if task in last_core and last_core[task] != core:
+                migrations += 1
+            running[core] = task
+            last_core[task] = core
+
+    if jobs == 0:
+        return None
+
+    ms = 1000 / trace.time_frequency_hz
+    return {
+        'makespan': (last_finish - first_arrival) * ms,
+        'turnaround': turnaround * ms / jobs,
+        'response': response * ms / jobs,
+        'preemptions': preemptions,
+        'migrations': migrations,
+        'dropped': trace.dropped,
+    }
+
+
+paths = []
+for path in sys.argv[1:]:
+    if os.path.isdir(path):
+        paths += [os.path.join(path, name) for name in sorted(os.listdir(path))]
+    else:
+        paths.append(path)
+
+results = []
+for path in paths:
+    try:
+        for trace in tf.traces(path):
+            result = analyze(trace)
+            if result is not None:
+                results.append(result)
+    except tf.TraceError as e:
+        print(f"{path}: {e}")
         exit(1)
 
-print(f"Discovered {sets} sets of data")
-
-# Find average makespan (total completion time)
-makespan_sum = 0
-for i in range(sets):
-    # Find the max ending time for the set
-    max_end = 0
-    for j in range(NUM_TASKS):
-        if (task_end_times[j][i] - task_arrival_times[j][i]) > max_end:
-            max_end = (task_end_times[j][i] - task_arrival_times[j][i])
-
-    makespan_sum = makespan_sum + max_end
-
-average_makespan = makespan_sum / sets
-
-# Find average turnaround time (task completion time)
-turnaround_sum = 0
-for i in range(sets):
-    for j in range(NUM_TASKS):
-        turnaround_sum = turnaround_sum + (task_end_times[j][i] - task_arrival_times[j][i])
-
-average_turnaround = turnaround_sum / (sets * NUM_TASKS)
+sets = len(results)
+if sets == 0:
+    print("No traces found")
+    exit(1)
 
-# Find average response time (time until first scheduled)
-response_sum = 0
-for i in range(sets):
-    # Assume all tasks arrive at t = 0ms
-    for j in range(NUM_TASKS):
-        response_sum = response_sum + (task_start_times[j][i] - task_arrival_times[j][i])
+print(f"Discovered {sets} sets of data")
 
-average_response = response_sum / (sets * NUM_TASKS)
+dropped = sum(r['dropped'] for r in results)
+if dropped != 0:
+    print(f"Warning: {dropped} trace records were dropped, make TRACE_BUFFER_LENGTH bigger")
 
 # Output the results
-print(f"Average makespan: {average_makespan:0.2f}ms")
-print(f"Average turnaround time: {average_turnaround:0.2f}ms")
-print(f"Average response time: {average_response:0.2f}ms")
\ No newline at end of file
+print(f"Average makespan: {sum(r['makespan'] for r in results) / sets:0.2f}ms")
+print(f"Average turnaround time: {sum(r['turnaround'] for r in results) / sets:0.2f}ms")
+print(f"Average response time: {sum(r['response'] for r in results) / sets:0.2f}ms")
+print(f"Average preemptions: {sum(r['preemptions'] for r in results) / sets:0.2f}")
+print(f"Average migrations: {sum(r['migrations'] for r in results) / sets:0.2f}")
@@ -1,52 +1,57 @@
 #!/usr/bin/python
+# Draws which task each core ran from the first trace in a run's output.
 import matplotlib.pyplot as plt
 from matplotlib import colors as mcolors
-import re
+import sys
 
-fig, ax = plt.subplots()
-
-COLORS = list(mcolors.TABLEAU_COLORS.values())
+import trace_format as tf
 
-print(COLORS)
+if len(sys.argv) != 2:
+    print("Missing trace path")
+    exit(1)
 
-#lst = [(3, 0), (2, 10), (1, 20), (0, 30), (4, 40), (5, 50), (6, 60), (7, 70), (0, 80), (3, 90), (-1, 100)]
-lst = []
+fig, ax = plt.subplots()
 
-with open('data/default_switching.log', 'r') as f:
-    for line in f:
-        m = re.match(r'^(\d+) \| Core0: BWorker(\d+)$', line)
-        if m is None:
-            continue
+COLORS = list(mcolors.TABLEAU_COLORS.values())
 
-        tick = int(m.group(1))
-        task = int(m.group(2))
+trace = next(tf.traces(sys.argv[1]), None)
+if trace is None:
+    print("No trace found")
+    exit(1)
 
-        lst.append((task, tick))
+# (task, time in ms) for each switch, per core
+switches = [[] for _ in range(trace.cores)]
+end = 0
+ms = 1000 / trace.time_frequency_hz
+for time, task, core, kind in trace.records():
+    time *= ms
+    if kind == tf.SWITCHED_IN:
+        switches[core].append((task, time))
+    end = time
 
-#Append finalizing mark
-# lst.append((-1, 101039)) # Used for EDF
-# lst.append((-1, 1001)) # Used for LLREF
-lst.append((-1, 251))
+tasks = sorted(set(task for core in switches for (task, _) in core))
+colors = {task: COLORS[i % len(COLORS)] for i, task in enumerate(tasks)}
 
-for i, x in enumerate(lst):
-    if x[0] == -1:
-        continue
-    ax.barh(0, width=lst[i+1][1] - lst[i][1], left=x[1], color=COLORS[x[0]])
+print(f'Tasks: {[trace.name(task) for task in tasks]}')
 
-tasks = list(set([a for (a, b) in lst if a != -1]))
+for core, lst in enumerate(switches):
+    # The last task runs until the end of the trace
+    lst.append((-1, end + 1))
 
-print(f'Tasks: {tasks}')
+    for i, x in enumerate(lst):
+        if x[0] == -1:
+            continue
+        ax.barh(core, width=lst[i+1][1] - lst[i][1], left=x[1], color=colors[x[0]])
 
-fig.set_figheight(0.5)
+fig.set_figheight(0.5 * trace.cores)
 fig.set_figwidth(8)
 
-plt.title('CPU0 Tasks (Default)')
-plt.legend([f'Task {i}' for i in tasks], bbox_to_anchor=(1.04, 1))
-leg = ax.get_legend()
-for (idx, task) in enumerate(tasks):
-    leg.legend_handles[idx].set_color(COLORS[task])
+plt.title('Tasks per core')
+handles = [plt.Rectangle((0, 0), 1, 1, color=colors[task]) for task in tasks]
+plt.legend(handles, [trace.name(task) for task in tasks], bbox_to_anchor=(1.04, 1))
 
 plt.xlabel("Time (ms)")
-ax.yaxis.set_visible(False)
+ax.set_yticks(range(trace.cores))
+ax.set_yticklabels([f'CPU{core}' for core in range(trace.cores)])
 #plt.show()
-plt.savefig('./test.png', bbox_inches='tight')
\ No newline at end of file
+plt.savefig('./test.png', bbox_inches='tight')
@@ -45,13 +45,19 @@
 
 #define configUSE_PREEMPTION                     1
 #define configUSE_IDLE_HOOK                      0
-#define configUSE_TICK_HOOK                      0
+#define configUSE_TICK_HOOK                      1
 #define configCPU_CLOCK_HZ                       ( ( unsigned long ) 25000000 )
 #define configTICK_RATE_HZ                       ( ( TickType_t ) 1000 )
 #define configMINIMAL_STACK_SIZE                 ( ( unsigned short ) 88 )
 #define configTOTAL_HEAP_SIZE                    ( ( size_t ) ( 60 * 1024 ) )
 #define configMAX_TASK_NAME_LEN                  ( 12 )
 
+/* Stop the tick while only the idle task can run, until the scheduler's next
+ * event.  Configure with -DTICKLESS_IDLE=ON. */
+#ifdef USE_TICKLESS_IDLE
+#define configUSE_TICKLESS_IDLE                  1
+#endif
+
 /* TODO TraceRecorder (Step 4): Enable configUSE_TRACE_FACILITY in FreeRTOSConfig.h. */
 #define configUSE_TRACE_FACILITY                 1
 
@@ -77,6 +83,11 @@
 #define configTIMER_QUEUE_LENGTH                 20
 #define configTIMER_TASK_STACK_DEPTH             ( configMINIMAL_STACK_SIZE * 2 )
 
+/* EDF: each batch of timer callbacks is due this many ticks after the timer
+ * service task is woken.  LLREF runs it in the time the periodic tasks leave,
+ * see configTIMER_TASK_EXECUTION_TIME. */
+#define configTIMER_TASK_DEADLINE                ( 5 )
+
 #define configUSE_TASK_NOTIFICATIONS             1
 #define configTASK_NOTIFICATION_ARRAY_ENTRIES    3
 
@@ -110,6 +121,18 @@
 #define configUSE_CORE_AFFINITY                 1
 #define configUSE_PASSIVE_IDLE_HOOK             0
 #define portSUPPORT_SMP                         1
+
+/* EDF: run partitioned rather than global EDF, every task stays on one core. */
+#ifdef USE_EDF_PARTITIONED
+#define configEDF_PARTITIONED                   1
+#define configEDF_PARTITION_HEURISTIC           EDF_PARTITION_FIRST_FIT
+#endif
+
+/* LLREF: prefer the core a task last ran on when the choice is within a tick. */
+#ifdef USE_LLREF_MIN_MIGRATIONS
+#define configLLREF_MINIMISE_MIGRATIONS         1
+#define configLLREF_MIGRATION_EPSILON           1
+#endif
 #endif
 
 /* This demo makes use of one or more example stats formatting functions. These
@@ -128,6 +151,11 @@
 // Since we are doing a custom implementation we want to ensure it is used
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION          0
 
+/* EDF: keep the ready tasks in a binary heap ordered by deadline so making a
+ * task ready or not ready is O(log n) rather than a walk of a sorted list. */
+#define configEDF_USE_READY_HEAP                         1
+#define configEDF_READY_HEAP_LENGTH                      ( 300 )
+
 /* The Win32 target is capable of running all the tests tasks at the same
  * time. */
 #define configRUN_ADDITIONAL_TESTS                       1
@@ -156,11 +184,31 @@
 
 #define configRUN_TIME_COUNTER_TYPE Time_t
 
+/* The POSIX port brings its own run time counter. */
+#ifndef PLATFORM_POSIX
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() do {} while(0)
 extern configRUN_TIME_COUNTER_TYPE get_runtime_counter(void);
 #define portGET_RUN_TIME_COUNTER_VALUE() get_runtime_counter();
+#endif
+
+/* The dpfair target is the LLREF kernel scheduling each TL-plane with DP-Fair. */
+#ifdef SCHED_DPFAIR
+#define configLLREF_DP_FAIR                     1
+#endif
+
+/* LLREF: charge tasks for the time they ran in counts of the benchmark time
+ * base rather than in whole ticks. */
+#define configLLREF_CYCLE_ACCOUNTING            1
+#define configLLREF_CYCLE_COUNT_TYPE            Time_t
+#define portLLREF_GET_CYCLE_COUNT()             get_current_time()
+#define configLLREF_CYCLES_PER_TICK             ( ( uint32_t ) ( ( get_time_frequency_ms() * 1000U ) / configTICK_RATE_HZ ) )
+
+/* Context switches are recorded in a per core ring buffer (Benchmarks/trace.c)
+ * and printed after the run, printing them here would slow down every switch. */
+extern void task_switched_in(void);
+#define traceTASK_SWITCHED_IN() task_switched_in();
 
-extern void print_new_task(void);
-#define traceTASK_SWITCHED_IN() print_new_task();
+extern void trace_task_created(void *task);
+#define traceTASK_CREATE( pxNewTCB ) trace_task_created( pxNewTCB );
 
 #endif /* FREERTOS_CONFIG_H */
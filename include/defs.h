@@ -1,14 +1,21 @@
 #ifndef DEFS_H
 #define DEFS_H
 
-//#define USE_SMP
+// USE_SMP is defined by the build, configure with -DSMP=ON to use it
 
 extern void app_abort(void);
 
-typedef uint32_t Time_t;
+// Counts of the platform time base, see get_time_frequency_ms()
+typedef uint64_t Time_t;
 
 uint32_t get_context_switch_count(void);
+// When the task running on this core was last switched in
+Time_t get_switched_in_time(void);
 Time_t get_current_time(void);
 Time_t get_time_frequency_ms(void);
 
+#if defined USE_SMP
+Time_t get_core_busy_time(uint32_t core);
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,200 @@
+#!/usr/bin/python
+# Runs the scheduler x task set x seed matrix of the tasksets benchmark in
+# parallel, one build per task set and seed and one run per scheduler.
+#
+#   ./matrix.py --tasksets "--tasks 8" --tasksets "--tasks 4 --period-distribution uniform" --seeds 1,2,3
+#
+# On qemu each run uses -icount with sleep off, so the guest clock advances
+# with the instructions it executes rather than with the host's. The results
+# are then the same however loaded the host is, and the runs can be spread
+# over every host core. Posix runs are native and keep wall clock timing.
+#
+# Every run leaves its output in <output>/<tasksets>/seed<N>/<scheduler>.out
+# and a line in <output>/results.jsonl.
+import argparse
+import concurrent.futures
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+
+ROOT = os.path.dirname(os.path.abspath(__file__))
+SCHEDULERS = ['edf', 'llref', 'dpfair', 'default']
+
+SET_LINE = re.compile(r'^set (\d+) \| level (\d+) \| util (\d+) \| (\d+) ticks \| '
+                      r'(\d+) jobs \| (\d+) missed \| (\d+) switches$')
+
+
+def slug(text):
+    # A directory name for a set of generator options
+    name = re.sub(r'[^A-Za-z0-9.]+', '_', text).strip('_')
+    return name if name else 'defaults'
+
+
+def build(args, tasksets, seed):
+    build_dir = os.path.join(args.build_dir, slug(tasksets), f'seed{seed}')
+    log_path = os.path.join(build_dir, 'build.log')
+    os.makedirs(build_dir, exist_ok=True)
+
+    configure = [
+        'cmake', '-S', ROOT, '-B', build_dir,
+        f'-DPLATFORM={args.platform}',
+        '-DBENCHMARK=tasksets',
+        f'-DTASKSET_ARGS={tasksets} --seed {seed}',
+    ]
+    compile = ['cmake', '--build', build_dir, '--parallel', str(args.build_jobs), '--target'] + args.schedulers
+
+    with open(log_path, 'w') as log:
+        for command in (configure, compile):
+            if subprocess.run(command, stdout=log, stderr=subprocess.STDOUT).returncode != 0:
+                return None
+
+    return build_dir
+
+
+def run_command(args, image):
+    if args.platform == 'posix':
+        return [image]
+
+    return [
+        'qemu-system-arm',
+        '-machine', 'mps2-an385',
+        '-kernel', image,
+        '-display', 'none',
+        '-monitor', 'none',
+        '-serial', 'stdio',
+        '-semihosting',
+        '-semihosting-config', 'enable=on,target=native,userspace=on',
+        '-icount', f'shift={args.icount_shift},align=off,sleep=off',
+        '-rtc', 'clock=vm',
+    ]
+
+
+def run(args, build_dir, tasksets, seed, scheduler):
+    out_dir = os.path.join(args.output, slug(tasksets), f'seed{seed}')
+    out_path = os.path.join(out_dir, f'{scheduler}.out')
+    os.makedirs(out_dir, exist_ok=True)
+
+    result = {
+        'scheduler': scheduler,
+        'platform': args.platform,
+        'tasksets': tasksets,
+        'seed': seed,
+        'output': os.path.relpath(out_path, args.output),
+    }
+
+    start = time.monotonic()
+    with open(out_path, 'w') as out:
+        process = subprocess.Popen(run_command(args, os.path.join(build_dir, scheduler)),
+                                   stdout=out, stderr=subprocess.STDOUT, stdin=subprocess.DEVNULL)
+        try:
+            process.wait(timeout=args.timeout)
+            result['status'] = 'ok' if process.returncode == 0 else 'failed'
+            result['returncode'] = process.returncode
+        except subprocess.TimeoutExpired:
+            process.kill()
+            process.wait()
+            result['status'] = 'timeout'
+            result['returncode'] = None
+    result['seconds'] = round(time.monotonic() - start, 3)
+
+    sets = []
+    finished = False
+    with open(out_path, 'r', errors='replace') as out:
+        for line in out:
+            line = line.strip()
+            if line == '----OUTPUT END----':
+                finished = True
+                continue
+
+            m = SET_LINE.match(line)
+            if m is None:
+                continue
+
+            sets.append({
+                'set': int(m.group(1)),
+                'level': int(m.group(2)),
+                'util': int(m.group(3)),
+                'ticks': int(m.group(4)),
+                'jobs': int(m.group(5)),
+                'missed': int(m.group(6)),
+                'switches': int(m.group(7)),
+            })
+
+    # A run that ended without the end marker did not get through every set
+    if result['status'] == 'ok' and not finished:
+        result['status'] = 'incomplete'
+    result['sets'] = sets
+
+    return result
+
+
+def int_list(text):
+    return [int(x) for x in text.split(',')]
+
+
+def name_list(text):
+    names = text.split(',')
+    for name in names:
+        if name not in SCHEDULERS:
+            raise argparse.ArgumentTypeError(f'Unknown scheduler {name}')
+    return names
+
+
+parser = argparse.ArgumentParser(description='Run the tasksets benchmark over schedulers, task sets and seeds in parallel')
+parser.add_argument('--platform', choices=['qemu', 'posix'], default='qemu')
+parser.add_argument('--schedulers', type=name_list, default=['edf', 'llref', 'dpfair'],
+                    help='Comma separated targets to run')
+parser.add_argument('--tasksets', action='append',
+                    help='Options for tasksets.py generate, may be given more than once')
+parser.add_argument('--seeds', type=int_list, default=[1], help='Comma separated generator seeds')
+parser.add_argument('--jobs', type=int, default=os.cpu_count(), help='Builds and runs at once')
+parser.add_argument('--timeout', type=float, default=1800, help='Seconds before a run is killed')
+parser.add_argument('--icount-shift', type=int, default=5,
+                    help='Each guest instruction takes 2^shift ns, 5 is close to the 25MHz mps2 clock')
+parser.add_argument('--build-dir', default=os.path.join(ROOT, 'build-matrix'))
+parser.add_argument('--output', default=None, help='Defaults to data/matrix/<platform>')
+args = parser.parse_args()
+
+if args.tasksets is None:
+    args.tasksets = ['']
+if args.output is None:
+    args.output = os.path.join(ROOT, 'data', 'matrix', args.platform)
+os.makedirs(args.output, exist_ok=True)
+
+configs = [(tasksets, seed) for tasksets in args.tasksets for seed in args.seeds]
+# Share the cores between the builds that run at once
+args.build_jobs = max(1, args.jobs // len(configs))
+print(f'{len(configs)} builds, {len(configs) * len(args.schedulers)} runs, {args.jobs} at once')
+
+failed = 0
+with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as pool:
+    builds = {pool.submit(build, args, tasksets, seed): (tasksets, seed) for tasksets, seed in configs}
+
+    runs = []
+    for future in concurrent.futures.as_completed(builds):
+        tasksets, seed = builds[future]
+        build_dir = future.result()
+        if build_dir is None:
+            print(f'Build failed for "{tasksets}" seed {seed}, see its build.log')
+            failed += len(args.schedulers)
+            continue
+
+        for scheduler in args.schedulers:
+            runs.append(pool.submit(run, args, build_dir, tasksets, seed, scheduler))
+
+    with open(os.path.join(args.output, 'results.jsonl'), 'w') as results:
+        for future in concurrent.futures.as_completed(runs):
+            result = future.result()
+            results.write(json.dumps(result) + '\n')
+            results.flush()
+
+            missed = sum(s['missed'] for s in result['sets'])
+            print(f'{result["scheduler"]} | "{result["tasksets"]}" | seed {result["seed"]} | '
+                  f'{result["status"]} | {len(result["sets"])} sets | {missed} missed | {result["seconds"]}s')
+            if result['status'] != 'ok':
+                failed += 1
+
+sys.exit(1 if failed else 0)
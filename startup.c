@@ -69,7 +69,7 @@
      0,
      0,
      0,
-     ( uint32_t * ) NULL,     // Timer 0
+     ( uint32_t * ) &TIMER0_Handler, // Timer 0
      ( uint32_t * ) NULL,     // Timer 1
      0,
      0,
@@ -0,0 +1,232 @@
+#!/usr/bin/python
+# Random periodic task sets for the tasksets benchmark.
+#
+#   ./tasksets.py generate -o build/tasksets.h --tasks 8 --utilizations 0.5,0.6,0.7,0.8,0.9,1.0 --sets 100
+#   ./tasksets.py summarize data/posix/edf/tasksets.out
+#
+# generate writes a C header with every set, which the benchmark runs one
+# after the other in a single boot. Utilizations are split between the tasks
+# with UUniFast (UUniFast-Discard above one core) or Randfixedsum, and the
+# periods are drawn uniformly, log-uniformly or from a fixed list.
+import argparse
+import math
+import random
+import re
+import sys
+
+
+def uunifast(rng, n, u):
+    utils = []
+    remaining = u
+    for i in range(1, n):
+        next_remaining = remaining * rng.random() ** (1.0 / (n - i))
+        utils.append(remaining - next_remaining)
+        remaining = next_remaining
+    utils.append(remaining)
+    return utils
+
+
+def uunifast_discard(rng, n, u):
+    # Above one core a single task could be handed more than a whole core
+    while True:
+        utils = uunifast(rng, n, u)
+        if max(utils) <= 1.0:
+            return utils
+
+
+def randfixedsum(rng, n, u):
+    # Stafford's algorithm for n values in [0, 1] that sum to u, drawn
+    # uniformly from that simplex. Indices follow the 1-based original.
+    s = u
+    k = max(min(int(math.floor(s)), n - 1), 0)
+    s = max(min(s, k + 1), k)
+    s1 = [0.0] + [s - (k - i) for i in range(n)]
+    s2 = [0.0] + [(k + n - i) - s for i in range(n)]
+
+    huge = sys.float_info.max
+    tiny = 2.0 ** -1074
+    w = [[0.0] * (n + 2) for _ in range(n + 1)]
+    w[1][2] = huge
+    t = [[0.0] * (n + 1) for _ in range(n)]
+    for i in range(2, n + 1):
+        for c in range(1, i + 1):
+            tmp1 = w[i - 1][c + 1] * s1[c] / i
+            tmp2 = w[i - 1][c] * s2[n - i + c] / i
+            w[i][c + 1] = tmp1 + tmp2
+            tmp3 = w[i][c + 1] + tiny
+            if s2[n - i + c] > s1[c]:
+                t[i - 1][c] = tmp2 / tmp3
+            else:
+                t[i - 1][c] = 1.0 - tmp1 / tmp3
+
+    x = [0.0] * (n + 1)
+    j = k + 1
+    sm = 0.0
+    pr = 1.0
+    for i in range(n - 1, 0, -1):
+        e = 1 if rng.random() <= t[i][j] else 0
+        sx = rng.random() ** (1.0 / i)
+        sm = sm + (1.0 - sx) * pr * s / (i + 1)
+        pr = sx * pr
+        x[n - i] = sm + pr * e
+        s = s - e
+        j = j - e
+    x[n] = sm + pr * s
+
+    utils = x[1:]
+    rng.shuffle(utils)
+    return utils
+
+
+# Sets pushed over their level by rounding are drawn again
+MAX_ATTEMPTS = 10000
+
+METHODS = {
+    'uunifast': uunifast_discard,
+    'randfixedsum': randfixedsum,
+}
+
+
+def draw_period(rng, args):
+    if args.period_distribution == 'uniform':
+        return rng.randint(args.period_min, args.period_max)
+    elif args.period_distribution == 'loguniform':
+        low = math.log(args.period_min)
+        high = math.log(args.period_max + 1)
+        return min(int(math.exp(rng.uniform(low, high))), args.period_max)
+    else:
+        return rng.choice(args.period_choices)
+
+
+def hyperperiod(periods):
+    h = 1
+    for p in periods:
+        h = h * p // math.gcd(h, p)
+    return h
+
+
+def generate(args):
+    rng = random.Random(args.seed)
+    generator = METHODS[args.method]
+
+    if args.period_distribution == 'choice' and not args.period_choices:
+        sys.exit('--period-choices is needed with the choice distribution')
+
+    sets = []
+    for level in args.utilizations:
+        if level > args.cores:
+            sys.exit(f'Utilization {level} does not fit on {args.cores} core(s)')
+        if level > args.tasks:
+            sys.exit(f'Utilization {level} cannot be split between {args.tasks} tasks')
+
+        for _ in range(args.sets):
+            for _ in range(MAX_ATTEMPTS):
+                utils = generator(rng, args.tasks, level)
+                periods = [draw_period(rng, args) for _ in utils]
+                # Rounding down keeps the set at or under its level, but a task
+                # still needs at least one tick, which can push it over
+                wcets = [min(p, max(1, int(u * p))) for u, p in zip(utils, periods)]
+                actual = sum(c / p for c, p in zip(wcets, periods))
+                if actual <= level:
+                    break
+            else:
+                sys.exit(f'No set under {level} in {MAX_ATTEMPTS} attempts, try longer periods or fewer tasks')
+
+            duration = min(hyperperiod(periods), args.duration)
+            sets.append((level, actual, duration, periods, wcets))
+
+    out = open(args.output, 'w') if args.output != '-' else sys.stdout
+    out.write('// Generated by tasksets.py, do not edit\n')
+    out.write('// ' + ' '.join(sys.argv[1:]) + '\n')
+    out.write('#ifndef TASKSETS_H\n')
+    out.write('#define TASKSETS_H\n\n')
+    out.write(f'#define TASKSETS_COUNT {len(sets)}\n')
+    out.write(f'#define TASKSETS_MAX_TASKS {args.tasks}\n')
+    out.write(f'#define TASKSETS_CORES {args.cores}\n\n')
+    out.write('typedef struct\n')
+    out.write('{\n')
+    out.write('    uint32_t level;       // Utilization the set was drawn for, in permille\n')
+    out.write('    uint32_t utilization; // Utilization after rounding, in permille\n')
+    out.write('    TickType_t duration;  // Ticks to run, the hyperperiod where it is short enough\n')
+    out.write('    uint32_t count;\n')
+    out.write('    TickType_t periods[TASKSETS_MAX_TASKS];\n')
+    out.write('    TickType_t wcets[TASKSETS_MAX_TASKS];\n')
+    out.write('} TaskSet;\n\n')
+    out.write('static const TaskSet tasksets[TASKSETS_COUNT] =\n')
+    out.write('{\n')
+    for level, actual, duration, periods, wcets in sets:
+        out.write(f'    {{ {round(level * 1000)}, {int(actual * 1000)}, {duration}, {len(periods)},\n')
+        out.write('      { ' + ', '.join(str(p) for p in periods) + ' },\n')
+        out.write('      { ' + ', '.join(str(c) for c in wcets) + ' } },\n')
+    out.write('};\n\n')
+    out.write('#endif\n')
+    if out is not sys.stdout:
+        out.close()
+
+
+def summarize(args):
+    levels = {}
+    for path in args.files:
+        with open(path, 'r') as f:
+            for line in f:
+                m = re.match(r'^set (\d+) \| level (\d+) \| util (\d+) \| (\d+) ticks \| '
+                             r'(\d+) jobs \| (\d+) missed \| (\d+) switches$', line.strip())
+                if m is None:
+                    continue
+
+                level = int(m.group(2))
+                ticks = int(m.group(4))
+                jobs = int(m.group(5))
+                missed = int(m.group(6))
+                switches = int(m.group(7))
+
+                entry = levels.setdefault(level, [0, 0, 0, 0, 0, 0])
+                entry[0] += 1
+                entry[1] += 1 if missed == 0 else 0
+                entry[2] += jobs
+                entry[3] += missed
+                entry[4] += switches
+                entry[5] += ticks
+
+    print('level | sets | schedulable | missed jobs | switches/1000 ticks')
+    for level in sorted(levels):
+        count, ok, jobs, missed, switches, ticks = levels[level]
+        miss_ratio = missed / jobs if jobs else 0
+        print(f'{level / 1000:0.3f} | {count} | {ok / count * 100:0.1f}% | '
+              f'{miss_ratio * 100:0.2f}% | {switches * 1000 / ticks:0.1f}')
+
+
+def float_list(text):
+    return [float(x) for x in text.split(',')]
+
+
+def int_list(text):
+    return [int(x) for x in text.split(',')]
+
+
+parser = argparse.ArgumentParser(description='Random periodic task sets for the tasksets benchmark')
+commands = parser.add_subparsers(dest='command', required=True)
+
+gen = commands.add_parser('generate', help='Write a header with the task sets')
+gen.add_argument('-o', '--output', default='-', help='Header to write, - for stdout')
+gen.add_argument('--tasks', type=int, default=8, help='Tasks in each set')
+gen.add_argument('--utilizations', type=float_list, default=float_list('0.5,0.6,0.7,0.8,0.9,0.95,1.0'),
+                 help='Comma separated total utilizations to draw sets for')
+gen.add_argument('--sets', type=int, default=100, help='Sets drawn for each utilization')
+gen.add_argument('--method', choices=METHODS.keys(), default='uunifast')
+gen.add_argument('--period-distribution', choices=['uniform', 'loguniform', 'choice'], default='loguniform')
+gen.add_argument('--period-min', type=int, default=10, help='Shortest period in ticks')
+gen.add_argument('--period-max', type=int, default=100, help='Longest period in ticks')
+gen.add_argument('--period-choices', type=int_list, help='Comma separated periods for the choice distribution')
+gen.add_argument('--duration', type=int, default=1000, help='Most ticks a set is run for')
+gen.add_argument('--cores', type=int, default=1, help='Cores the sets are scheduled on')
+gen.add_argument('--seed', type=int, default=1)
+
+summ = commands.add_parser('summarize', help='Schedulability per utilization level from benchmark output')
+summ.add_argument('files', nargs='+')
+
+args = parser.parse_args()
+if args.command == 'generate':
+    generate(args)
+else:
+    summarize(args)
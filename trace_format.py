@@ -0,0 +1,137 @@
+# Decoder for the binary traces written by Benchmarks/trace.c, see trace.h for
+# the layout. A trace can be read from a raw file or from a console log where
+# it was dumped as hex between the TRACE markers, and the records are decoded
+# a chunk at a time so a trace never has to fit in memory.
+import struct
+
+MAGIC = b'FRTR'
+VERSION = 2
+
+HEADER = struct.Struct('<4sHHIBBHII')
+# The last four bytes of a record are padding
+RECORD = struct.Struct('<QHBB4x')
+
+SWITCHED_IN = 0
+JOB_ARRIVED = 1
+JOB_STARTED = 2
+JOB_FINISHED = 3
+
+TRACE_START = '---TRACE START---'
+TRACE_END = '----TRACE END----'
+
+CHUNK_BYTES = 1 << 20
+
+
+class TraceError(Exception):
+    pass
+
+
+class Trace:
+    def __init__(self, header, names, chunks, leftover):
+        (magic, self.version, record_size, self.time_frequency_hz, self.cores,
+         name_length, name_count, self.record_count, self.dropped) = header
+        self.names = names
+        self._chunks = chunks
+        self._buffer = leftover
+        self._remaining = self.record_count
+
+    def name(self, task):
+        if task < len(self.names) and self.names[task]:
+            return self.names[task]
+        return f'Task{task}'
+
+    def records(self):
+        # Yields (time, task, core, type) in time order, only once
+        while self._remaining > 0:
+            usable = min(len(self._buffer) // RECORD.size, self._remaining) * RECORD.size
+            if usable == 0:
+                chunk = next(self._chunks, None)
+                if chunk is None:
+                    raise TraceError(f'Trace ended {self._remaining} records early')
+                self._buffer += chunk
+                continue
+
+            block = self._buffer[:usable]
+            self._buffer = self._buffer[usable:]
+            self._remaining -= usable // RECORD.size
+            yield from RECORD.iter_unpack(block)
+
+    def skip(self):
+        for _ in self.records():
+            pass
+        for _ in self._chunks:
+            pass
+
+
+def _read_exactly(chunks, buffer, length):
+    while len(buffer) < length:
+        chunk = next(chunks, None)
+        if chunk is None:
+            raise TraceError('Trace ended inside its header')
+        buffer += chunk
+    return buffer[:length], buffer[length:]
+
+
+def _decode(chunks):
+    chunks = iter(chunks)
+
+    raw, rest = _read_exactly(chunks, b'', HEADER.size)
+    header = HEADER.unpack(raw)
+    magic, version, record_size = header[0:3]
+    if magic != MAGIC:
+        raise TraceError(f'Not a trace, the magic is {magic!r}')
+    if version != VERSION:
+        raise TraceError(f'Trace format version {version}, only {VERSION} is understood')
+    if record_size != RECORD.size:
+        raise TraceError(f'Records are {record_size} bytes, expected {RECORD.size}')
+
+    name_length, name_count = header[5], header[6]
+    raw, rest = _read_exactly(chunks, rest, name_length * name_count)
+    names = [raw[i * name_length:(i + 1) * name_length].split(b'\0', 1)[0].decode('ascii', 'replace')
+             for i in range(name_count)]
+
+    return Trace(header, names, chunks, rest)
+
+
+def _raw_chunks(f):
+    while True:
+        chunk = f.read(CHUNK_BYTES)
+        if not chunk:
+            return
+        yield chunk
+
+
+def _hex_chunks(lines):
+    # Stops at the end marker so the lines after it are left for the caller
+    pending = []
+    size = 0
+    for line in lines:
+        line = line.strip()
+        if line == TRACE_END:
+            break
+        pending.append(line)
+        size += len(line)
+        if size >= CHUNK_BYTES:
+            yield bytes.fromhex(''.join(pending))
+            pending = []
+            size = 0
+    if pending:
+        yield bytes.fromhex(''.join(pending))
+
+
+def traces(path):
+    # Yields every trace in the file. Finish with the records of one trace
+    # before asking for the next.
+    with open(path, 'rb') as f:
+        if f.read(len(MAGIC)) == MAGIC:
+            f.seek(0)
+            yield _decode(_raw_chunks(f))
+            return
+
+    with open(path, 'r', errors='replace') as f:
+        for line in f:
+            if line.strip() == TRACE_START:
+                trace = _decode(_hex_chunks(f))
+                yield trace
+                # Past whatever of the trace was not read, up to its end marker
+                trace.skip()